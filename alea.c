@@ -0,0 +1,128 @@
+#include "alea.h"
+#include <string.h>
+
+// Tourne un entier de 64 bits de k bits vers la gauche
+#define ROTATION(x, k) (((x) << (k)) | ((x) >> (64 - (k))))
+
+// **********************************
+// Declarations des fonctions privees
+// **********************************
+/**
+ * @brief Tire le prochain entier de la suite splitmix64, qui sert a etaler une graine.
+ * @name splitmix_suivant
+ * @param etat l'etat de la suite, avance a chaque appel
+ * @return le prochain entier de la suite
+ */
+uint64_t splitmix_suivant(uint64_t *etat);
+
+// ***********************************
+// Definitions des fonctions publiques
+// ***********************************
+void alea_init(t_alea *alea, uint64_t graine)
+{
+  // splitmix64 ne donne jamais quatre zeros de suite : l'etat ne peut pas etre entierement nul
+  for (int i = 0; i < 4; i++)
+  {
+    alea->etat[i] = splitmix_suivant(&graine);
+  }
+}
+
+void alea_init_flux(t_alea *alea, uint64_t graine, uint64_t numero)
+{
+  // Le numero est d'abord melange, pour que des numeros voisins donnent des graines sans rapport
+  alea_init(alea, graine ^ splitmix_suivant(&numero));
+}
+
+uint64_t alea_suivant(t_alea *alea)
+{
+  uint64_t *s = alea->etat;
+  uint64_t resultat = ROTATION(s[1] * 5, 7) * 9;
+  uint64_t t = s[1] << 17;
+
+  s[2] ^= s[0];
+  s[3] ^= s[1];
+  s[1] ^= s[2];
+  s[0] ^= s[3];
+  s[2] ^= t;
+  s[3] = ROTATION(s[3], 45);
+  return resultat;
+}
+
+void alea_sauter(t_alea *alea)
+{
+  // Le polynome du saut de 2^128 donne par les auteurs de xoshiro256**
+  static const uint64_t saut[4] = {0x180ec6d33cfd0abaULL, 0xd5a61266f0c9392cULL, 0xa9582618e03fc9aaULL, 0x39abdc4529b1661cULL};
+  uint64_t nouvel_etat[4] = {0, 0, 0, 0};
+
+  for (int i = 0; i < 4; i++)
+  {
+    for (int bit = 0; bit < 64; bit++)
+    {
+      if (saut[i] & ((uint64_t)1 << bit))
+      {
+        for (int j = 0; j < 4; j++)
+        {
+          nouvel_etat[j] ^= alea->etat[j];
+        }
+      }
+      alea_suivant(alea);
+    }
+  }
+  memcpy(alea->etat, nouvel_etat, sizeof(nouvel_etat));
+}
+
+uint32_t alea_borne(t_alea *alea, uint32_t borne)
+{
+  // Les 32 bits de poids fort du produit tombent dans [0, borne[ ; les tirages dont les bits de
+  // poids faible tombent dans les 2^32 mod borne premieres valeurs sont rejetes pour supprimer le biais
+  uint64_t produit = (alea_suivant(alea) >> 32) * borne;
+  uint32_t bas = (uint32_t)produit;
+  if (bas < borne)
+  {
+    uint32_t seuil = -borne % borne;
+    while (bas < seuil)
+    {
+      produit = (alea_suivant(alea) >> 32) * borne;
+      bas = (uint32_t)produit;
+    }
+  }
+  return (uint32_t)(produit >> 32);
+}
+
+int alea_entre(t_alea *alea, int min, int max)
+{
+  uint32_t etendue = (uint32_t)max - (uint32_t)min + 1;
+  if (etendue == 0) // [INT_MIN, INT_MAX] : toutes les valeurs conviennent
+  {
+    return (int)(uint32_t)(alea_suivant(alea) >> 32);
+  }
+  return (int)((uint32_t)min + alea_borne(alea, etendue));
+}
+
+void alea_remplir(t_alea *alea, void *tampon, size_t taille)
+{
+  uint8_t *octets = tampon;
+  while (taille >= sizeof(uint64_t))
+  {
+    uint64_t tirage = alea_suivant(alea);
+    memcpy(octets, &tirage, sizeof(tirage));
+    octets += sizeof(tirage);
+    taille -= sizeof(tirage);
+  }
+  if (taille > 0)
+  {
+    uint64_t tirage = alea_suivant(alea);
+    memcpy(octets, &tirage, taille);
+  }
+}
+
+// *********************************
+// Definitions des fonctions privees
+// *********************************
+uint64_t splitmix_suivant(uint64_t *etat)
+{
+  uint64_t z = (*etat += 0x9e3779b97f4a7c15ULL);
+  z = (z ^ (z >> 30)) * 0xbf58476d1ce4e5b9ULL;
+  z = (z ^ (z >> 27)) * 0x94d049bb133111ebULL;
+  return z ^ (z >> 31);
+}
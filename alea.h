@@ -0,0 +1,89 @@
+#ifndef CODE_ALEA_H
+#define CODE_ALEA_H
+
+#include <stddef.h> // Pour le type size_t
+#include <stdint.h> // Pour les types uint32_t et uint64_t
+
+// *****************************
+// Definitions des types publics
+// *****************************
+
+/**
+ * @brief Etat d'un generateur de nombres pseudo-aleatoires xoshiro256**.
+ * Chaque generateur a son propre etat : deux fils d'execution qui tirent chacun dans le leur n'ont
+ * rien a partager, et une meme graine redonne la meme suite sur toutes les plateformes.
+ */
+typedef struct
+{
+  uint64_t etat[4]; // L'etat interne, jamais entierement nul
+} t_alea;
+
+// ************************************
+// Declarations des fonctions publiques
+// ************************************
+
+/**
+ * @brief Initialise un generateur a partir d'une graine, etalee sur les 256 bits d'etat par splitmix64.
+ * @name alea_init
+ * @param alea le generateur a initialiser
+ * @param graine la graine (toute valeur convient, 0 compris)
+ */
+void alea_init(t_alea *alea, uint64_t graine);
+
+/**
+ * @brief Initialise le generateur numero numero d'une famille issue d'une meme graine. Chaque membre
+ * ne depend que de la graine et de son numero : une tache numerotee retrouve le meme generateur quel
+ * que soit le fil qui l'execute, ou l'ordre des taches.
+ * @name alea_init_flux
+ * @param alea le generateur a initialiser
+ * @param graine la graine de la famille
+ * @param numero le numero du generateur dans la famille
+ */
+void alea_init_flux(t_alea *alea, uint64_t graine, uint64_t numero);
+
+/**
+ * @brief Tire le prochain entier de 64 bits de la suite.
+ * @name alea_suivant
+ * @param alea le generateur
+ * @return un entier uniforme sur les 64 bits
+ */
+uint64_t alea_suivant(t_alea *alea);
+
+/**
+ * @brief Avance le generateur de 2^128 tirages d'un coup. Pour obtenir des suites independantes,
+ * on copie un generateur puis on fait sauter l'original entre chaque copie : la suite de chaque
+ * copie ne peut pas recouvrir celle de la suivante.
+ * @name alea_sauter
+ * @param alea le generateur
+ */
+void alea_sauter(t_alea *alea);
+
+/**
+ * @brief Tire un entier uniforme dans [0, borne[, sans le biais du modulo (methode de Lemire).
+ * @name alea_borne
+ * @param alea le generateur
+ * @param borne le nombre de valeurs possibles (au moins 1)
+ * @return un entier entre 0 et borne - 1
+ */
+uint32_t alea_borne(t_alea *alea, uint32_t borne);
+
+/**
+ * @brief Tire un entier uniforme dans [min, max], bornes comprises.
+ * @name alea_entre
+ * @param alea le generateur
+ * @param min la plus petite valeur possible
+ * @param max la plus grande valeur possible (au moins min)
+ * @return un entier entre min et max
+ */
+int alea_entre(t_alea *alea, int min, int max);
+
+/**
+ * @brief Remplit un tampon d'octets aleatoires, huit octets par tirage.
+ * @name alea_remplir
+ * @param alea le generateur
+ * @param tampon le tampon a remplir
+ * @param taille le nombre d'octets a ecrire
+ */
+void alea_remplir(t_alea *alea, void *tampon, size_t taille);
+
+#endif // CODE_ALEA_H
@@ -0,0 +1,499 @@
+#include "autonomie.h"
+#include "dijkstra.h" // Pour NB_CASES_BONUS et l'affichage des directions suggerees
+#include "util.h"     // Pour utiliser ABS et MAX
+#include <stdint.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+
+// ****************************
+// Definitions des types prives
+// ****************************
+// Nombre de bits du numero de groupe d'une station, et nombre de groupes entre lesquels les stations
+// sont reparties pour resumer les chemins
+#define BITS_GROUPE_STATION 3
+#define NB_GROUPES_STATIONS (1 << BITS_GROUPE_STATION)
+
+// Groupe d'une station, tire des bits de poids fort d'un hachage multiplicatif de son indice
+#define GROUPE_STATION(indice) (int)(((uint32_t)(indice) * 2654435761u) >> (32 - BITS_GROUPE_STATION))
+
+// Type pour une etiquette : un etat (case, carburant) atteint par un chemin depuis le depart.
+// Le chemin se retrouve en remontant les parents ; il sert aussi a savoir quelles stations ont
+// deja ete videes, ce qui rend le calcul du carburant exact meme quand le chemin repasse sur une case.
+// Pour ce dernier usage, on ne remonte que les etiquettes entrees dans une station ; le carburant
+// ramasse par groupe de stations resume ces chaines, et tranche le plus souvent la comparaison de
+// deux etiquettes sans les remonter.
+typedef struct
+{
+  int indice;            // L'indice lineaire de la case atteinte
+  int carburant;         // Le carburant du joueur en arrivant sur la case
+  int nb_pas;            // Le nombre de deplacements depuis le depart
+  int parent;            // L'etiquette d'ou l'on vient, -1 pour le depart
+  int station;           // La derniere etiquette du chemin entree dans une station, -1 s'il n'y en a pas
+  int ramasse[NB_GROUPES_STATIONS]; // Le carburant ramasse depuis le depart dans les stations de chaque groupe (GROUPE_STATION)
+  t_direction direction; // La direction prise depuis la case du parent
+  bool vivante;          // Indique si l'etiquette doit encore etre developpee
+} t_etiquette;
+
+
+
+// L'espace de travail. Les etiquettes de la recherche en cours sont rangees par nombre de pas
+// croissant : le tableau sert a la fois de file et de memoire des chemins. Les places et le compte
+// des etiquettes d'une case ne valent que si la case porte le numero de la recherche en cours.
+struct s_autonomie
+{
+  const t_terrain *terrain;  // Le terrain des recherches
+  long long carburant_total; // Le carburant de toutes les stations du terrain
+  t_etiquette *etiquettes;   // Les etiquettes de la recherche en cours
+  int nb_etiquettes;         // Le nombre d'etiquettes de la recherche en cours
+  int capacite;              // Le nombre d'etiquettes allouables sans reallocation, conserve d'une recherche a l'autre
+  int *par_case;             // Les etiquettes conservees de chaque case, -1 pour une place libre
+  int *nb_conservees;        // Le nombre d'etiquettes conservees par chaque case depuis le debut de la recherche
+  uint32_t *generations;     // Le numero de la derniere recherche qui a touche chaque case
+  uint32_t generation;       // Le numero de la recherche en cours
+};
+
+// **********************************
+// Declarations des fonctions privees
+// **********************************
+/**
+ * @brief Commence une nouvelle recherche : aucune etiquette, et toutes les cases sans etiquette
+ * conservee. Se fait en temps constant en changeant le numero de la recherche en cours.
+ * @name commencer_recherche
+ * @param recherche l'espace de travail
+ */
+void commencer_recherche(t_autonomie *recherche);
+
+/**
+ * @brief Vide les places et le compte des etiquettes d'une case si elle n'a pas encore ete touchee
+ * par la recherche en cours. Doit preceder toute lecture de ses places.
+ * @name toucher_places
+ * @param recherche l'espace de travail
+ * @param indice l'indice lineaire de la case
+ */
+void toucher_places(t_autonomie *recherche, int indice);
+
+/**
+ * @brief Cree une etiquette a la fin du tableau.
+ * @name ajouter_etiquette
+ * @param recherche la recherche
+ * @param indice l'indice lineaire de la case atteinte
+ * @param carburant le carburant en arrivant sur la case
+ * @param nb_pas le nombre de deplacements depuis le depart
+ * @param parent l'etiquette d'ou l'on vient, -1 pour le depart
+ * @param direction la direction prise depuis la case du parent
+ * @return le numero de l'etiquette creee, -1 si la memoire manque
+ */
+int ajouter_etiquette(t_autonomie *recherche, int indice, int carburant, int nb_pas, int parent, t_direction direction);
+
+/**
+ * @brief Indique si la station d'une case a deja ete videe par le chemin d'une etiquette.
+ * @name station_videe
+ * @param recherche la recherche
+ * @param etiquette le numero de l'etiquette dont on remonte le chemin
+ * @param indice l'indice lineaire de la case
+ * @return true si le chemin est deja entre dans la case, false sinon
+ */
+bool station_videe(const t_autonomie *recherche, int etiquette, int indice);
+
+/**
+ * @brief Cree une etiquette et la conserve pour sa case si aucune autre ne la domine.
+ * Les etiquettes qu'elle domine sont abandonnees ; si la case est pleine, la moins pourvue
+ * en carburant est abandonnee, ce qui borne le travail par case.
+ * @name conserver_si_non_dominee
+ * @param recherche la recherche
+ * @param indice l'indice lineaire de la case atteinte
+ * @param carburant le carburant en arrivant sur la case
+ * @param nb_pas le nombre de deplacements depuis le depart
+ * @param parent l'etiquette d'ou l'on vient
+ * @param direction la direction prise depuis la case du parent
+ * @return false si la memoire manque, true sinon
+ */
+bool conserver_si_non_dominee(t_autonomie *recherche, int indice, int carburant, int nb_pas, int parent, t_direction direction);
+
+/**
+ * @brief Indique si une etiquette en domine une autre de la meme case : elle a ete atteinte en au
+ * plus autant de pas et, quelle que soit la suite du chemin, elle aura au moins autant de carburant.
+ * Il ne suffit pas qu'elle ait plus de carburant : son avance doit couvrir les stations qu'elle a
+ * deja videes et que l'autre etiquette peut encore ramasser. Le carburant que chacune a ramasse dans
+ * chaque groupe de stations encadre ces stations et tranche le plus souvent en temps constant ;
+ * sinon on remonte les deux chemins.
+ * @name domine
+ * @param recherche la recherche
+ * @param a le numero de l'etiquette qui domine peut-etre
+ * @param b le numero de l'etiquette qui est peut-etre dominee
+ * @return true si a domine b, false sinon
+ */
+bool domine(const t_autonomie *recherche, int a, int b);
+
+// ***********************************
+// Definitions des fonctions publiques
+// ***********************************
+t_autonomie *autonomie_creer(const t_terrain *terrain)
+{
+  t_autonomie *autonomie = malloc(sizeof(t_autonomie));
+  if (autonomie == NULL)
+  {
+    return NULL;
+  }
+  size_t nb_cases = (size_t)terrain->nb_cases;
+  autonomie->terrain = terrain;
+  autonomie->etiquettes = NULL;
+  autonomie->nb_etiquettes = 0;
+  autonomie->capacite = 0;
+  autonomie->par_case = malloc(nb_cases * AUTONOMIE_ETIQUETTES_PAR_CASE * sizeof(int));
+  autonomie->nb_conservees = malloc(nb_cases * sizeof(int));
+  autonomie->generations = calloc(nb_cases, sizeof(uint32_t)); // Aucune case touchee : la premiere recherche a le numero 1
+  autonomie->generation = 0;
+  if (autonomie->par_case == NULL || autonomie->nb_conservees == NULL || autonomie->generations == NULL)
+  {
+    autonomie_detruire(autonomie);
+    return NULL;
+  }
+
+  // Le carburant total du terrain borne ce que le joueur peut encore ramasser ; il est ensuite tenu a jour
+  autonomie->carburant_total = 0;
+  for (int ligne = 0; ligne < terrain->nb_lignes; ligne++)
+  {
+    for (int colonne = 0; colonne < terrain->nb_colonnes; colonne++)
+    {
+      autonomie->carburant_total += terrain->cases[terrain_indice(terrain, ligne, colonne)];
+    }
+  }
+  return autonomie;
+}
+
+void autonomie_detruire(t_autonomie *autonomie)
+{
+  if (autonomie != NULL)
+  {
+    free(autonomie->etiquettes);
+    free(autonomie->par_case);
+    free(autonomie->nb_conservees);
+    free(autonomie->generations);
+    free(autonomie);
+  }
+}
+
+void autonomie_signaler_case_modifiee(t_autonomie *autonomie, int ligne, int colonne, int ancien_carburant)
+{
+  autonomie->carburant_total += terrain_get_carburant(autonomie->terrain, ligne, colonne) - ancien_carburant;
+}
+
+int autonomie_chercher_chemin(t_autonomie *autonomie, int depart_ligne, int depart_colonne, int carburant, int destination_ligne, int destination_colonne, t_direction directions[], int nb_max, int *carburant_final)
+{
+  if (depart_ligne == destination_ligne && depart_colonne == destination_colonne)
+  {
+    if (carburant_final != NULL)
+    {
+      *carburant_final = carburant;
+    }
+    return 0;
+  }
+  if (carburant <= 0)
+  {
+    return -1;
+  }
+
+  t_autonomie *recherche = autonomie;
+  const t_terrain *terrain = recherche->terrain;
+  commencer_recherche(recherche);
+  long long carburant_terrain = recherche->carburant_total;
+
+  int depart = terrain_indice(terrain, depart_ligne, depart_colonne);
+  int destination = terrain_indice(terrain, destination_ligne, destination_colonne);
+  int meilleure = -1;
+  int meilleur_carburant = -1;
+  if (ajouter_etiquette(recherche, depart, carburant, 0, -1, DIRECTION_ERRONEE) < 0)
+  {
+    return -1;
+  }
+  toucher_places(recherche, depart);
+  recherche->par_case[(size_t)depart * AUTONOMIE_ETIQUETTES_PAR_CASE] = 0;
+
+  for (int i = 0; i < recherche->nb_etiquettes; i++)
+  {
+    t_etiquette etiquette = recherche->etiquettes[i];
+    if (!etiquette.vivante)
+    {
+      continue;
+    }
+
+    // Le carburant ramasse jusqu'ici vaut carburant - carburant initial + nb_pas : meme en vidant
+    // tout le reste du terrain et en filant droit vers la sortie, on ne ferait pas mieux que cette borne
+    int distance = ABS(destination_ligne - terrain_ligne(terrain, etiquette.indice)) +
+                   ABS(destination_colonne - terrain_colonne(terrain, etiquette.indice));
+    if (carburant + carburant_terrain - etiquette.nb_pas - distance <= meilleur_carburant)
+    {
+      continue;
+    }
+
+    for (t_direction direction = DIRECTION_DROITE; direction <= DIRECTION_GAUCHE; direction++)
+    {
+      int voisin = TERRAIN_VOISINE(terrain, etiquette.indice, direction);
+      if (terrain->cases[voisin] == TERRAIN_BORDURE)
+      {
+        continue;
+      }
+
+      int gain = terrain->cases[voisin];
+      if (gain > 0 && station_videe(recherche, i, voisin))
+      {
+        gain = 0;
+      }
+      int nouveau_carburant = etiquette.carburant + gain - COUT_DEPLACEMENT_VOISIN;
+
+      if (voisin == destination)
+      {
+        // La partie est gagnee des l'arrivee : la sortie n'est jamais developpee
+        if (nouveau_carburant > meilleur_carburant)
+        {
+          int arrivee = ajouter_etiquette(recherche, voisin, nouveau_carburant, etiquette.nb_pas + 1, i, direction);
+          if (arrivee < 0)
+          {
+            return -1;
+          }
+          recherche->etiquettes[arrivee].vivante = false;
+          meilleure = arrivee;
+          meilleur_carburant = nouveau_carburant;
+        }
+      }
+      else if (nouveau_carburant > 0 &&
+               !conserver_si_non_dominee(recherche, voisin, nouveau_carburant, etiquette.nb_pas + 1, i, direction))
+      {
+        // Une etiquette perdue fausserait le resultat : la recherche echoue
+        return -1;
+      }
+    }
+  }
+
+  int nb_pas = -1;
+  if (meilleure >= 0)
+  {
+    nb_pas = recherche->etiquettes[meilleure].nb_pas;
+    for (int e = meilleure; recherche->etiquettes[e].parent >= 0; e = recherche->etiquettes[e].parent)
+    {
+      int position = recherche->etiquettes[e].nb_pas - 1;
+      if (position < nb_max)
+      {
+        directions[position] = recherche->etiquettes[e].direction;
+      }
+    }
+    if (carburant_final != NULL)
+    {
+      *carburant_final = meilleur_carburant;
+    }
+  }
+
+  return nb_pas;
+}
+
+bool autonomie_acheter_bonus(t_autonomie *autonomie, int joueur_ligne, int joueur_colonne, int *joueur_carburant, int destination_ligne, int destination_colonne)
+{
+  if (*joueur_carburant < 10)
+  {
+    printf("Pas assez de carburant pour acheter le bonus.\n");
+    return false;
+  }
+
+  t_direction directions[NB_CASES_BONUS];
+  int carburant_final;
+  int nb_pas = autonomie_chercher_chemin(autonomie, joueur_ligne, joueur_colonne, *joueur_carburant - 10, destination_ligne, destination_colonne, directions, NB_CASES_BONUS, &carburant_final);
+  if (nb_pas <= 0)
+  {
+    return false;
+  }
+
+  *joueur_carburant -= 10;
+  dijkstra_afficher_directions_suggerees(directions, MIN(nb_pas, NB_CASES_BONUS));
+  printf("Carburant a l'arrivee en suivant ce chemin : %d\n", carburant_final);
+  return true;
+}
+
+// *********************************
+// Definitions des fonctions privees
+// *********************************
+void commencer_recherche(t_autonomie *recherche)
+{
+  recherche->nb_etiquettes = 0;
+  recherche->generation++;
+  if (recherche->generation == 0)
+  {
+    // Apres 2^32 recherches, les numeros rebouclent : on efface une fois pour toutes les anciens numeros
+    memset(recherche->generations, 0, (size_t)recherche->terrain->nb_cases * sizeof(uint32_t));
+    recherche->generation = 1;
+  }
+}
+
+void toucher_places(t_autonomie *recherche, int indice)
+{
+  if (recherche->generations[indice] != recherche->generation)
+  {
+    recherche->generations[indice] = recherche->generation;
+    recherche->nb_conservees[indice] = 0;
+    for (int k = 0; k < AUTONOMIE_ETIQUETTES_PAR_CASE; k++)
+    {
+      recherche->par_case[(size_t)indice * AUTONOMIE_ETIQUETTES_PAR_CASE + k] = -1;
+    }
+  }
+}
+
+int ajouter_etiquette(t_autonomie *recherche, int indice, int carburant, int nb_pas, int parent, t_direction direction)
+{
+  if (recherche->nb_etiquettes == recherche->capacite)
+  {
+    int nouvelle_capacite = recherche->capacite > 0 ? 2 * recherche->capacite : 256;
+    t_etiquette *etiquettes = realloc(recherche->etiquettes, (size_t)nouvelle_capacite * sizeof(t_etiquette));
+    if (etiquettes == NULL)
+    {
+      return -1;
+    }
+    recherche->etiquettes = etiquettes;
+    recherche->capacite = nouvelle_capacite;
+  }
+
+  t_etiquette *etiquette = &recherche->etiquettes[recherche->nb_etiquettes];
+  etiquette->indice = indice;
+  etiquette->carburant = carburant;
+  etiquette->nb_pas = nb_pas;
+  etiquette->parent = parent;
+  if (parent < 0)
+  {
+    etiquette->station = -1;
+    memset(etiquette->ramasse, 0, sizeof(etiquette->ramasse));
+  }
+  else
+  {
+    const t_etiquette *precedente = &recherche->etiquettes[parent];
+    memcpy(etiquette->ramasse, precedente->ramasse, sizeof(etiquette->ramasse));
+    etiquette->station = precedente->station;
+    if (recherche->terrain->cases[indice] > 0)
+    {
+      // Ce qui a ete ramasse se lit dans le carburant : une station deja videe par le chemin ne rapporte rien
+      etiquette->station = recherche->nb_etiquettes;
+      etiquette->ramasse[GROUPE_STATION(indice)] += carburant - precedente->carburant + COUT_DEPLACEMENT_VOISIN;
+    }
+  }
+  etiquette->direction = direction;
+  etiquette->vivante = true;
+  return recherche->nb_etiquettes++;
+}
+
+bool station_videe(const t_autonomie *recherche, int etiquette, int indice)
+{
+  // La case de depart n'a pas ete videe : seules les cases ou l'on est entre comptent
+  for (int e = recherche->etiquettes[etiquette].station; e >= 0; e = recherche->etiquettes[recherche->etiquettes[e].parent].station)
+  {
+    if (recherche->etiquettes[e].indice == indice)
+    {
+      return true;
+    }
+  }
+  return false;
+}
+
+bool domine(const t_autonomie *recherche, int a, int b)
+{
+  const t_etiquette *etiquette_a = &recherche->etiquettes[a];
+  const t_etiquette *etiquette_b = &recherche->etiquettes[b];
+  if (etiquette_a->nb_pas > etiquette_b->nb_pas || etiquette_a->carburant < etiquette_b->carburant)
+  {
+    return false;
+  }
+
+  // L'avance en carburant de a doit couvrir les stations que a a videes et que b peut encore ramasser.
+  // Dans chaque groupe, ces stations rapportent au plus ce que a y a ramasse, et au moins ce que a y a
+  // ramasse de plus que b
+  int marge = etiquette_a->carburant - etiquette_b->carburant;
+  if (etiquette_a->station == etiquette_b->station)
+  {
+    return true;
+  }
+  int plafond = 0;
+  int plancher = 0;
+  for (int groupe = 0; groupe < NB_GROUPES_STATIONS; groupe++)
+  {
+    plafond += etiquette_a->ramasse[groupe];
+    plancher += MAX(etiquette_a->ramasse[groupe] - etiquette_b->ramasse[groupe], 0);
+  }
+  if (plafond <= marge)
+  {
+    return true;
+  }
+  if (plancher > marge)
+  {
+    return false;
+  }
+  for (int e = etiquette_a->station; e >= 0; e = recherche->etiquettes[recherche->etiquettes[e].parent].station)
+  {
+    int indice = recherche->etiquettes[e].indice;
+    int station = recherche->terrain->cases[indice];
+    if (!station_videe(recherche, b, indice))
+    {
+      marge -= station;
+      if (marge < 0)
+      {
+        return false;
+      }
+    }
+  }
+  return true;
+}
+
+bool conserver_si_non_dominee(t_autonomie *recherche, int indice, int carburant, int nb_pas, int parent, t_direction direction)
+{
+  toucher_places(recherche, indice);
+  if (recherche->nb_conservees[indice] >= AUTONOMIE_CONSERVEES_PAR_CASE)
+  {
+    return true;
+  }
+  int nouvelle = ajouter_etiquette(recherche, indice, carburant, nb_pas, parent, direction);
+  if (nouvelle < 0)
+  {
+    return false;
+  }
+
+  int *places = &recherche->par_case[(size_t)indice * AUTONOMIE_ETIQUETTES_PAR_CASE];
+  int place_libre = -1;
+  int place_plus_pauvre = -1;
+  for (int k = 0; k < AUTONOMIE_ETIQUETTES_PAR_CASE; k++)
+  {
+    if (places[k] < 0)
+    {
+      place_libre = k;
+    }
+    else if (domine(recherche, places[k], nouvelle))
+    {
+      // La nouvelle etiquette n'apporte rien : elle est la derniere creee, on la retire
+      recherche->nb_etiquettes--;
+      return true;
+    }
+    else if (domine(recherche, nouvelle, places[k]))
+    {
+      // La nouvelle etiquette domine celle-ci, qui n'a plus a etre developpee
+      recherche->etiquettes[places[k]].vivante = false;
+      places[k] = -1;
+      place_libre = k;
+    }
+    else if (place_plus_pauvre < 0 || recherche->etiquettes[places[k]].carburant < recherche->etiquettes[places[place_plus_pauvre]].carburant)
+    {
+      place_plus_pauvre = k;
+    }
+  }
+
+  if (place_libre < 0)
+  {
+    // Case pleine : on garde les etiquettes les mieux pourvues en carburant
+    int plus_pauvre = places[place_plus_pauvre];
+    if (recherche->etiquettes[plus_pauvre].carburant >= carburant)
+    {
+      recherche->nb_etiquettes--;
+      return true;
+    }
+    recherche->etiquettes[plus_pauvre].vivante = false;
+    place_libre = place_plus_pauvre;
+  }
+  places[place_libre] = nouvelle;
+  recherche->nb_conservees[indice]++;
+  return true;
+}
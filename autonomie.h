@@ -0,0 +1,100 @@
+#ifndef CODE_AUTONOMIE_H
+#define CODE_AUTONOMIE_H
+
+#include <stdbool.h> // Pour le type bool
+#include "jeu.h"     // Pour le type t_direction
+#include "terrain.h" // Pour le type t_terrain
+
+// Nombre maximal d'etiquettes (niveau de carburant, nombre de pas) conservees en meme temps par case
+#define AUTONOMIE_ETIQUETTES_PAR_CASE 4
+
+// Nombre maximal d'etiquettes conservees par case sur toute la recherche, qui borne son temps de calcul
+#define AUTONOMIE_CONSERVEES_PAR_CASE 16
+
+// *****************************
+// Definitions des types publics
+// *****************************
+
+/**
+ * @brief Espace de travail de la recherche de chemins praticables, lie a un terrain et conserve d'un
+ * appel a l'autre. Ses tableaux par case sont remis a zero en temps constant entre deux recherches
+ * (numero de recherche par case, comme le contexte de dijkstra), et il tient a jour le carburant total
+ * des stations, qui borne ce que le joueur peut encore ramasser : une recherche ne coute que les cases
+ * qu'elle touche.
+ */
+typedef struct s_autonomie t_autonomie;
+
+// ************************************
+// Declarations des fonctions publiques
+// ************************************
+
+/**
+ * @brief Alloue l'espace de travail d'un terrain et fait le compte de son carburant, en un parcours du terrain.
+ * @name autonomie_creer
+ * @param terrain le terrain, qui doit rester alloue tant que l'espace de travail sert
+ * @return l'espace de travail, NULL si la memoire manque
+ */
+t_autonomie *autonomie_creer(const t_terrain *terrain);
+
+/**
+ * @brief Libere un espace de travail.
+ * @name autonomie_detruire
+ * @param autonomie l'espace de travail a liberer (peut etre NULL)
+ */
+void autonomie_detruire(t_autonomie *autonomie);
+
+/**
+ * @brief Indique a l'espace de travail que le carburant d'une case du terrain a change, pour tenir a
+ * jour le carburant total des stations.
+ * @name autonomie_signaler_case_modifiee
+ * @param autonomie l'espace de travail
+ * @param ligne la ligne de la case modifiee
+ * @param colonne la colonne de la case modifiee
+ * @param ancien_carburant le carburant de la case avant la modification
+ */
+void autonomie_signaler_case_modifiee(t_autonomie *autonomie, int ligne, int colonne, int ancien_carburant);
+
+/**
+ * @brief Cherche un chemin que le joueur peut reellement parcourir jusqu'a la sortie avec son
+ * carburant, en cherchant a maximiser le carburant qui lui restera a l'arrivee.
+ * Chaque deplacement coute COUT_DEPLACEMENT_VOISIN et rapporte le carburant de la station
+ * d'arrivee, une station videe ne rapportant plus rien : le carburant doit rester positif
+ * jusqu'a la sortie.
+ * La recherche developpe des etiquettes (case, carburant) par nombre de pas croissant. Une
+ * etiquette est ecartee si une autre etiquette de la meme case a au moins autant de carburant en
+ * au plus autant de pas, ou si meme en vidant toutes les stations restantes elle ne peut pas
+ * battre le meilleur chemin deja trouve. Ces deux regles sont exactes ; mais comme les stations se
+ * vident au passage, le nombre d'etats utiles peut croitre exponentiellement, et le nombre
+ * d'etiquettes par case est donc borne. Le resultat est un meilleur effort : le chemin retourne est
+ * toujours praticable, et il laisse le plus de carburant possible tant qu'aucune case n'a atteint
+ * ses bornes ; sinon, il peut en laisser un peu moins que le meilleur chemin.
+ * @name autonomie_chercher_chemin
+ * @param autonomie l'espace de travail du terrain sur lequel chercher le chemin
+ * @param depart_ligne la ligne ou se trouve le joueur
+ * @param depart_colonne la colonne ou se trouve le joueur
+ * @param carburant le carburant du joueur au depart
+ * @param destination_ligne la ligne de la sortie
+ * @param destination_colonne la colonne de la sortie
+ * @param directions le tableau ou deposer les premieres directions du chemin
+ * @param nb_max le nombre maximal de directions a deposer
+ * @param carburant_final l'adresse ou deposer le carburant restant a l'arrivee (peut etre NULL)
+ * @return le nombre total de deplacements du chemin, -1 si aucun chemin praticable n'a ete trouve
+ * ou si la memoire manque
+ */
+int autonomie_chercher_chemin(t_autonomie *autonomie, int depart_ligne, int depart_colonne, int carburant, int destination_ligne, int destination_colonne, t_direction directions[], int nb_max, int *carburant_final);
+
+/**
+ * @brief Achete un bonus au prix de 10L de carburant et affiche les 4 premieres directions d'un
+ * chemin praticable avec le carburant restant apres l'achat.
+ * @name autonomie_acheter_bonus
+ * @param autonomie l'espace de travail du terrain sur lequel le joueur evolue
+ * @param joueur_ligne la ligne ou se trouve le joueur
+ * @param joueur_colonne la colonne ou se trouve le joueur
+ * @param joueur_carburant l'adresse de la quantite de carburant du joueur
+ * @param destination_ligne la ligne de la sortie
+ * @param destination_colonne la colonne de la sortie
+ * @return true si un chemin praticable a ete affiche et le bonus debite, false sinon (rien n'est debite)
+ */
+bool autonomie_acheter_bonus(t_autonomie *autonomie, int joueur_ligne, int joueur_colonne, int *joueur_carburant, int destination_ligne, int destination_colonne);
+
+#endif // CODE_AUTONOMIE_H
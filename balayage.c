@@ -0,0 +1,240 @@
+#include "balayage.h"
+#include <limits.h>
+#include <stdlib.h>
+#if defined(__AVX2__) || defined(__SSE4_1__)
+#include <immintrin.h>
+#endif
+
+// ****************************
+// Definitions des types prives
+// ****************************
+// Type pour la grille de travail : lignes completees jusqu'a un multiple de BALAYAGE_LARGEUR_VECTEUR
+typedef struct
+{
+  int nb_lignes;    // Le nombre de lignes du terrain
+  int nb_colonnes;  // Le nombre de colonnes du terrain
+  int largeur;      // Le nombre d'entiers par ligne, colonnes de remplissage comprises
+  int *couts;       // Le meilleur cout connu de chaque case, COUT_INFINI si aucun
+  int *poids;       // Le cout d'entree dans chaque case, COUT_INFINI pour le remplissage
+  int *versions;    // Le nombre de fois ou chaque ligne a change
+  int *vus_dessus;  // Pour chaque ligne, la version de la ligne du dessus quand elle a ete relachee depuis celle-ci
+  int *vus_dessous; // Pour chaque ligne, la version de la ligne du dessous quand elle a ete relachee depuis celle-ci
+} t_grille;
+
+// Cout des cases non atteintes : assez loin de INT_MAX pour qu'on puisse encore y ajouter un cout d'entree
+#define COUT_INFINI (INT_MAX / 2)
+
+// **********************************
+// Declarations des fonctions privees
+// **********************************
+/**
+ * @brief Met a jour une ligne depuis sa voisine du dessus ou du dessous : relache les deplacements
+ * verticaux puis, si la ligne a change, ses deplacements horizontaux. Rien n'est fait si la voisine
+ * n'a pas change depuis la derniere mise a jour de la ligne dans ce sens.
+ * @name mettre_a_jour_ligne
+ * @param grille la grille
+ * @param source la ligne voisine d'ou viennent les deplacements verticaux
+ * @param ligne la ligne a mettre a jour
+ * @return true si au moins un cout a baisse, false sinon
+ */
+bool mettre_a_jour_ligne(t_grille *grille, int source, int ligne);
+
+/**
+ * @brief Libere la grille de travail.
+ * @name liberer_grille
+ * @param grille la grille
+ */
+void liberer_grille(t_grille *grille);
+
+/**
+ * @brief Relache les deplacements verticaux d'une ligne vers une ligne voisine, un vecteur de cases a la fois.
+ * @name relacher_verticalement
+ * @param grille la grille
+ * @param source la ligne d'ou viennent les deplacements
+ * @param ligne la ligne a mettre a jour
+ * @return true si au moins un cout a baisse, false sinon
+ */
+bool relacher_verticalement(t_grille *grille, int source, int ligne);
+
+/**
+ * @brief Relache les deplacements horizontaux d'une ligne, de gauche a droite puis de droite a gauche.
+ * @name relacher_horizontalement
+ * @param grille la grille
+ * @param ligne la ligne a mettre a jour
+ */
+void relacher_horizontalement(t_grille *grille, int ligne);
+
+// ***********************************
+// Definitions des fonctions publiques
+// ***********************************
+bool balayage_calculer_couts(const t_terrain *terrain, int source_ligne, int source_colonne, int couts[], int *nb_balayages)
+{
+  if (!terrain_contient(terrain, source_ligne, source_colonne))
+  {
+    return false;
+  }
+
+  t_grille grille;
+  grille.nb_lignes = terrain->nb_lignes;
+  grille.nb_colonnes = terrain->nb_colonnes;
+  grille.largeur = (terrain->nb_colonnes + BALAYAGE_LARGEUR_VECTEUR - 1) / BALAYAGE_LARGEUR_VECTEUR * BALAYAGE_LARGEUR_VECTEUR;
+  // Des lignes alignees sur 32 octets permettent les chargements alignes du noyau vectoriel
+  size_t taille = (size_t)grille.nb_lignes * (size_t)grille.largeur * sizeof(int);
+  taille = (taille + 31) / 32 * 32;
+  grille.couts = aligned_alloc(32, taille);
+  grille.poids = aligned_alloc(32, taille);
+  grille.versions = calloc((size_t)grille.nb_lignes, sizeof(int));
+  grille.vus_dessus = malloc((size_t)grille.nb_lignes * sizeof(int));
+  grille.vus_dessous = malloc((size_t)grille.nb_lignes * sizeof(int));
+  if (grille.couts == NULL || grille.poids == NULL || grille.versions == NULL || grille.vus_dessus == NULL || grille.vus_dessous == NULL)
+  {
+    liberer_grille(&grille);
+    return false;
+  }
+
+  for (int ligne = 0; ligne < grille.nb_lignes; ligne++)
+  {
+    grille.vus_dessus[ligne] = -1;
+    grille.vus_dessous[ligne] = -1;
+    for (int colonne = 0; colonne < grille.largeur; colonne++)
+    {
+      int indice = ligne * grille.largeur + colonne;
+      grille.couts[indice] = COUT_INFINI;
+      grille.poids[indice] = colonne < grille.nb_colonnes
+                                 ? 1 + (STATION_MAX_CARBURANT - terrain->cases[terrain_indice(terrain, ligne, colonne)])
+                                 : COUT_INFINI;
+    }
+  }
+  grille.couts[source_ligne * grille.largeur + source_colonne] = 0;
+  relacher_horizontalement(&grille, source_ligne);
+  grille.versions[source_ligne]++;
+
+  // Les lignes qui ne touchent aucune ligne modifiee sont sautees : les derniers balayages sont presque gratuits
+  int balayages = 0;
+  bool modifie = true;
+  while (modifie)
+  {
+    modifie = false;
+    for (int ligne = 1; ligne < grille.nb_lignes; ligne++)
+    {
+      modifie |= mettre_a_jour_ligne(&grille, ligne - 1, ligne);
+    }
+    for (int ligne = grille.nb_lignes - 2; ligne >= 0; ligne--)
+    {
+      modifie |= mettre_a_jour_ligne(&grille, ligne + 1, ligne);
+    }
+    balayages++;
+  }
+
+  for (int ligne = 0; ligne < grille.nb_lignes; ligne++)
+  {
+    for (int colonne = 0; colonne < grille.nb_colonnes; colonne++)
+    {
+      int cout = grille.couts[ligne * grille.largeur + colonne];
+      couts[terrain_indice(terrain, ligne, colonne)] = cout >= COUT_INFINI ? INT_MAX : cout;
+    }
+  }
+  if (nb_balayages != NULL)
+  {
+    *nb_balayages = balayages;
+  }
+  liberer_grille(&grille);
+  return true;
+}
+
+// *********************************
+// Definitions des fonctions privees
+// *********************************
+bool mettre_a_jour_ligne(t_grille *grille, int source, int ligne)
+{
+  int *vus = source < ligne ? grille->vus_dessus : grille->vus_dessous;
+  if (vus[ligne] == grille->versions[source])
+  {
+    return false;
+  }
+  vus[ligne] = grille->versions[source];
+
+  if (!relacher_verticalement(grille, source, ligne))
+  {
+    return false;
+  }
+  relacher_horizontalement(grille, ligne);
+  grille->versions[ligne]++;
+  return true;
+}
+
+void liberer_grille(t_grille *grille)
+{
+  free(grille->couts);
+  free(grille->poids);
+  free(grille->versions);
+  free(grille->vus_dessus);
+  free(grille->vus_dessous);
+}
+
+bool relacher_verticalement(t_grille *grille, int source, int ligne)
+{
+  const int *depart = &grille->couts[source * grille->largeur];
+  const int *poids = &grille->poids[ligne * grille->largeur];
+  int *arrivee = &grille->couts[ligne * grille->largeur];
+
+#if defined(__AVX2__)
+  __m256i baisses = _mm256_setzero_si256();
+  for (int colonne = 0; colonne < grille->largeur; colonne += 8)
+  {
+    __m256i proposes = _mm256_add_epi32(_mm256_load_si256((const __m256i *)&depart[colonne]),
+                                        _mm256_load_si256((const __m256i *)&poids[colonne]));
+    __m256i actuels = _mm256_load_si256((const __m256i *)&arrivee[colonne]);
+    baisses = _mm256_or_si256(baisses, _mm256_cmpgt_epi32(actuels, proposes));
+    _mm256_store_si256((__m256i *)&arrivee[colonne], _mm256_min_epi32(actuels, proposes));
+  }
+  return !_mm256_testz_si256(baisses, baisses);
+#elif defined(__SSE4_1__)
+  __m128i baisses = _mm_setzero_si128();
+  for (int colonne = 0; colonne < grille->largeur; colonne += 4)
+  {
+    __m128i proposes = _mm_add_epi32(_mm_load_si128((const __m128i *)&depart[colonne]),
+                                     _mm_load_si128((const __m128i *)&poids[colonne]));
+    __m128i actuels = _mm_load_si128((const __m128i *)&arrivee[colonne]);
+    baisses = _mm_or_si128(baisses, _mm_cmpgt_epi32(actuels, proposes));
+    _mm_store_si128((__m128i *)&arrivee[colonne], _mm_min_epi32(actuels, proposes));
+  }
+  return !_mm_testz_si128(baisses, baisses);
+#else
+  bool baisse = false;
+  for (int colonne = 0; colonne < grille->largeur; colonne++)
+  {
+    int propose = depart[colonne] + poids[colonne];
+    if (propose < arrivee[colonne])
+    {
+      arrivee[colonne] = propose;
+      baisse = true;
+    }
+  }
+  return baisse;
+#endif
+}
+
+void relacher_horizontalement(t_grille *grille, int ligne)
+{
+  int *couts = &grille->couts[ligne * grille->largeur];
+  const int *poids = &grille->poids[ligne * grille->largeur];
+
+  // Chaque case depend de celle qu'on vient de mettre a jour : ce parcours reste scalaire
+  for (int colonne = 1; colonne < grille->nb_colonnes; colonne++)
+  {
+    int propose = couts[colonne - 1] + poids[colonne];
+    if (propose < couts[colonne])
+    {
+      couts[colonne] = propose;
+    }
+  }
+  for (int colonne = grille->nb_colonnes - 2; colonne >= 0; colonne--)
+  {
+    int propose = couts[colonne + 1] + poids[colonne];
+    if (propose < couts[colonne])
+    {
+      couts[colonne] = propose;
+    }
+  }
+}
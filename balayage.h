@@ -0,0 +1,39 @@
+#ifndef CODE_BALAYAGE_H
+#define CODE_BALAYAGE_H
+
+#include <stdbool.h> // Pour le type bool
+#include "terrain.h" // Pour le type t_terrain
+
+// Nombre d'entiers traites ensemble par le noyau de relaxation (8 avec AVX2, 4 avec SSE4.1, 1 sinon)
+#if defined(__AVX2__)
+#define BALAYAGE_LARGEUR_VECTEUR 8
+#elif defined(__SSE4_1__)
+#define BALAYAGE_LARGEUR_VECTEUR 4
+#else
+#define BALAYAGE_LARGEUR_VECTEUR 1
+#endif
+
+// ************************************
+// Declarations des fonctions publiques
+// ************************************
+
+/**
+ * @brief Calcule le cout du plus court chemin d'une case vers toutes les cases du terrain par
+ * balayages successifs de la grille (fast sweeping), jusqu'a ce qu'un balayage ne change plus rien.
+ * Chaque balayage parcourt les lignes de haut en bas puis de bas en haut ; pour chaque ligne, les
+ * deplacements verticaux depuis la ligne precedente sont relaches d'un bloc, avec les instructions
+ * vectorielles si le programme est compile avec -mavx2 ou -msse4.1, puis les deplacements
+ * horizontaux le sont par deux passes dans la ligne. Sur une grille dense, quelques balayages
+ * suffisent, sans file de priorite.
+ * @name balayage_calculer_couts
+ * @param terrain le terrain
+ * @param source_ligne la ligne de la case de depart
+ * @param source_colonne la colonne de la case de depart
+ * @param couts le tableau de terrain->nb_cases entiers ou deposer le cout de chaque case, indice comme
+ * les cases du terrain (voir terrain_indice), INT_MAX pour une case inaccessible
+ * @param nb_balayages l'adresse ou deposer le nombre de balayages effectues (peut etre NULL)
+ * @return true si le calcul a abouti, false si la case de depart est hors du terrain ou si la memoire manque
+ */
+bool balayage_calculer_couts(const t_terrain *terrain, int source_ligne, int source_colonne, int couts[], int *nb_balayages);
+
+#endif // CODE_BALAYAGE_H
@@ -0,0 +1,157 @@
+// Banc d'essai du passage a l'echelle de delta_calculer_couts, pour 1, 2, 4... fils.
+// - Passage a l'echelle fort : le meme terrain pour tous les nombres de fils ; on attend un temps
+//   divise par le nombre de fils (efficacite = acceleration / nombre de fils, 1 dans l'ideal).
+// - Passage a l'echelle faible : un terrain dont la surface croit avec le nombre de fils, pour un
+//   meme nombre de cases par fil ; on attend un temps constant (efficacite = temps a 1 fil / temps).
+// Les couts doivent etre ceux du calcul a un fil (fort) et ceux de dijkstra_calculer_cout sur le coin
+// oppose (faible). Les mesures n'ont de sens que sur une machine qui a au moins nb_fils_max coeurs.
+//
+// Compilation, depuis ce dossier :
+//   gcc -O2 -std=c11 -I.. banc_delta.c $(ls ../*.c | grep -v main.c) -pthread -o banc_delta
+// Utilisation : ./banc_delta [cote] [nb_fils_max] [largeur_seau] [graine]
+#define _POSIX_C_SOURCE 200809L // Pour clock_gettime
+#include "alea.h"
+#include "delta.h"
+#include "dijkstra.h"
+#include "terrain.h"
+#include <stdbool.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <time.h>
+
+// Cote du terrain du passage a l'echelle fort, et du terrain a un fil du passage a l'echelle faible
+#define COTE_DEFAUT 2000
+
+// Nombre de fils maximal par defaut
+#define NB_FILS_MAX_DEFAUT 8
+
+// Largeur des seaux par defaut
+#define LARGEUR_SEAU_DEFAUT 4
+
+/**
+ * @brief Donne le temps ecoule depuis une origine fixe, en millisecondes.
+ * @name horloge_ms
+ * @return le temps en millisecondes
+ */
+double horloge_ms(void);
+
+/**
+ * @brief Cree un terrain d'un tiers de stations au carburant tire au hasard.
+ * @name tirer_terrain
+ * @param nb_lignes le nombre de lignes
+ * @param nb_colonnes le nombre de colonnes
+ * @param alea le generateur
+ * @return le terrain, NULL si la memoire manque
+ */
+t_terrain *tirer_terrain(int nb_lignes, int nb_colonnes, t_alea *alea);
+
+/**
+ * @brief Chronometre un calcul depuis le coin superieur gauche.
+ * @name chronometrer_delta
+ * @param terrain le terrain
+ * @param largeur_seau la largeur des seaux
+ * @param nb_fils le nombre de fils
+ * @param couts le tableau ou deposer les couts
+ * @return la duree du calcul en millisecondes, -1 s'il n'a pas abouti
+ */
+double chronometrer_delta(const t_terrain *terrain, int largeur_seau, int nb_fils, int couts[]);
+
+int main(int argc, char *argv[])
+{
+  int cote = argc > 1 ? atoi(argv[1]) : COTE_DEFAUT;
+  int nb_fils_max = argc > 2 ? atoi(argv[2]) : NB_FILS_MAX_DEFAUT;
+  int largeur_seau = argc > 3 ? atoi(argv[3]) : LARGEUR_SEAU_DEFAUT;
+  t_alea alea;
+  alea_init(&alea, argc > 4 ? strtoull(argv[4], NULL, 10) : 1);
+  if (cote < 1 || nb_fils_max < 1 || largeur_seau < 1)
+  {
+    printf("Utilisation : %s [cote] [nb_fils_max] [largeur_seau] [graine]\n", argv[0]);
+    return 1;
+  }
+
+  // Passage a l'echelle fort
+  t_terrain *terrain = tirer_terrain(cote, cote, &alea);
+  int *reference = terrain == NULL ? NULL : malloc((size_t)terrain->nb_cases * sizeof(int));
+  int *couts = terrain == NULL ? NULL : malloc((size_t)terrain->nb_cases * sizeof(int));
+  if (reference == NULL || couts == NULL)
+  {
+    printf("Memoire insuffisante pour un terrain de %d x %d\n", cote, cote);
+    return 1;
+  }
+  printf("Passage a l'echelle fort : %d x %d, largeur des seaux %d\n", cote, cote, largeur_seau);
+  printf("%6s %12s %12s %12s %8s\n", "fils", "temps ms", "acceleration", "efficacite", "couts");
+  double temps_un_fil = chronometrer_delta(terrain, largeur_seau, 1, reference);
+  bool identiques = temps_un_fil >= 0;
+  printf("%6d %12.1f %12.2f %12.2f %8s\n", 1, temps_un_fil, 1.0, 1.0, identiques ? "-" : "ECHEC");
+  for (int nb_fils = 2; identiques && nb_fils <= nb_fils_max; nb_fils *= 2)
+  {
+    double temps = chronometrer_delta(terrain, largeur_seau, nb_fils, couts);
+    identiques = temps >= 0 && memcmp(couts, reference, (size_t)terrain->nb_cases * sizeof(int)) == 0;
+    printf("%6d %12.1f %12.2f %12.2f %8s\n", nb_fils, temps, temps_un_fil / temps, temps_un_fil / temps / nb_fils, identiques ? "egaux" : "ECART");
+  }
+  free(reference);
+  free(couts);
+  terrain_detruire(terrain);
+
+  // Passage a l'echelle faible : cote * racine(nb_fils), arrondi, pour cote * cote cases par fil
+  printf("\nPassage a l'echelle faible : %d x %d cases par fil, largeur des seaux %d\n", cote, cote, largeur_seau);
+  printf("%6s %12s %12s %12s %8s\n", "fils", "cote", "temps ms", "efficacite", "couts");
+  for (int nb_fils = 1; identiques && nb_fils <= nb_fils_max; nb_fils *= 2)
+  {
+    int cote_faible = cote;
+    while ((long long)cote_faible * cote_faible < (long long)cote * cote * nb_fils)
+    {
+      cote_faible++;
+    }
+    terrain = tirer_terrain(cote_faible, cote_faible, &alea);
+    couts = terrain == NULL ? NULL : malloc((size_t)terrain->nb_cases * sizeof(int));
+    if (couts == NULL)
+    {
+      printf("Memoire insuffisante pour un terrain de %d x %d\n", cote_faible, cote_faible);
+      terrain_detruire(terrain);
+      return 1;
+    }
+    double temps = chronometrer_delta(terrain, largeur_seau, nb_fils, couts);
+    if (nb_fils == 1)
+    {
+      temps_un_fil = temps;
+    }
+    int coin = couts[terrain_indice(terrain, cote_faible - 1, cote_faible - 1)];
+    identiques = temps >= 0 && coin == dijkstra_calculer_cout(NULL, terrain, 0, 0, cote_faible - 1, cote_faible - 1, NULL);
+    printf("%6d %12d %12.1f %12.2f %8s\n", nb_fils, cote_faible, temps, temps_un_fil / temps, identiques ? "egaux" : "ECART");
+    free(couts);
+    terrain_detruire(terrain);
+  }
+  return identiques ? 0 : 1;
+}
+
+double horloge_ms(void)
+{
+  struct timespec instant;
+  clock_gettime(CLOCK_MONOTONIC, &instant);
+  return (double)instant.tv_sec * 1e3 + (double)instant.tv_nsec / 1e6;
+}
+
+t_terrain *tirer_terrain(int nb_lignes, int nb_colonnes, t_alea *alea)
+{
+  t_terrain *terrain = terrain_creer(nb_lignes, nb_colonnes);
+  for (int i = 0; terrain != NULL && i < nb_lignes; i++)
+  {
+    for (int j = 0; j < nb_colonnes; j++)
+    {
+      terrain->cases[terrain_indice(terrain, i, j)] = alea_borne(alea, 3) == 0 ? (uint8_t)alea_entre(alea, 1, STATION_MAX_CARBURANT) : 0;
+    }
+  }
+  return terrain;
+}
+
+double chronometrer_delta(const t_terrain *terrain, int largeur_seau, int nb_fils, int couts[])
+{
+  double debut = horloge_ms();
+  if (!delta_calculer_couts(terrain, 0, 0, largeur_seau, nb_fils, couts))
+  {
+    return -1;
+  }
+  return horloge_ms() - debut;
+}
@@ -0,0 +1,141 @@
+// Banc d'essai de la disposition des cases en memoire pour l'algorithme de Dijkstra : par lignes
+// (TERRAIN_DISPOSITION_LIGNES) ou par tuiles (TERRAIN_DISPOSITION_TUILES), avec le tas et les seaux,
+// sur des terrains de 4000 x 4000 cases et plus, qui debordent largement des caches.
+// Les deux terrains d'une taille ont les memes cases : les couts des quatre mesures doivent etre egaux.
+//
+// Compilation, depuis ce dossier :
+//   gcc -O2 -std=c11 -I.. banc_disposition.c $(ls ../*.c | grep -v main.c) -pthread -o banc_disposition
+// Utilisation : ./banc_disposition [graine] [cote...]   (cotes par defaut : 4000 6000 8000)
+#define _POSIX_C_SOURCE 200809L // Pour clock_gettime
+#include "alea.h"
+#include "dijkstra.h"
+#include "terrain.h"
+#include <stdbool.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <time.h>
+
+// Nombre de requetes mesurees par terrain, par disposition et par file
+#define NB_REQUETES 2
+
+/**
+ * @brief Donne le temps ecoule depuis une origine fixe, en millisecondes.
+ * @name instant_ms
+ * @return le temps en millisecondes
+ */
+double instant_ms(void);
+
+/**
+ * @brief Remplit un terrain d'un tiers de stations, tirees case par case dans l'ordre des lignes
+ * quelle que soit la disposition : deux terrains remplis depuis la meme graine sont identiques.
+ * @name remplir_stations
+ * @param terrain le terrain
+ * @param graine la graine du tirage
+ */
+void remplir_stations(t_terrain *terrain, uint64_t graine);
+
+/**
+ * @brief Mesure la duree moyenne d'une requete d'un coin a l'autre d'un terrain avec une file donnee.
+ * @name mesurer_requetes
+ * @param terrain le terrain
+ * @param moteur la file de priorite
+ * @param cout l'adresse ou deposer le cout de la derniere requete
+ * @return la duree moyenne d'une requete en millisecondes, -1 si la memoire manque
+ */
+double mesurer_requetes(const t_terrain *terrain, t_dijkstra_moteur moteur, int *cout);
+
+int main(int argc, char *argv[])
+{
+  static const int cotes_defaut[] = {4000, 6000, 8000};
+  uint64_t graine = argc > 1 ? strtoull(argv[1], NULL, 10) : 1;
+  int nb_cotes = argc > 2 ? argc - 2 : (int)(sizeof(cotes_defaut) / sizeof(cotes_defaut[0]));
+  static const t_dijkstra_moteur moteurs[2] = {DIJKSTRA_MOTEUR_TAS, DIJKSTRA_MOTEUR_SEAUX};
+  static const char *noms_moteurs[2] = {"tas", "seaux"};
+
+  printf("%8s %8s %14s %14s %10s %8s\n", "cote", "file", "lignes ms", "tuiles ms", "gain", "couts");
+  for (int k = 0; k < nb_cotes; k++)
+  {
+    int cote = argc > 2 ? atoi(argv[k + 2]) : cotes_defaut[k];
+
+    // Un seul terrain a la fois par disposition, pour tenir en memoire sur les plus grands cotes
+    double temps[2][2];
+    int couts[2][2];
+    const t_terrain_disposition dispositions[2] = {TERRAIN_DISPOSITION_LIGNES, TERRAIN_DISPOSITION_TUILES};
+    for (int d = 0; d < 2; d++)
+    {
+      t_terrain *terrain = terrain_creer_disposition(cote, cote, dispositions[d]);
+      if (terrain == NULL)
+      {
+        printf("Memoire insuffisante pour un terrain de %d x %d\n", cote, cote);
+        return 1;
+      }
+      remplir_stations(terrain, graine);
+      for (int m = 0; m < 2; m++)
+      {
+        temps[d][m] = mesurer_requetes(terrain, moteurs[m], &couts[d][m]);
+        if (temps[d][m] < 0)
+        {
+          printf("Memoire insuffisante pour un contexte de %d x %d\n", cote, cote);
+          terrain_detruire(terrain);
+          return 1;
+        }
+      }
+      terrain_detruire(terrain);
+    }
+
+    bool identiques = couts[0][0] == couts[0][1] && couts[0][0] == couts[1][0] && couts[0][0] == couts[1][1];
+    for (int m = 0; m < 2; m++)
+    {
+      printf("%8d %8s %14.1f %14.1f %9.2fx %8s\n", cote, noms_moteurs[m], temps[0][m], temps[1][m], temps[0][m] / temps[1][m], identiques ? "egaux" : "ECART");
+    }
+    if (!identiques)
+    {
+      return 1;
+    }
+  }
+  return 0;
+}
+
+double instant_ms(void)
+{
+  struct timespec instant;
+  clock_gettime(CLOCK_MONOTONIC, &instant);
+  return (double)instant.tv_sec * 1e3 + (double)instant.tv_nsec / 1e6;
+}
+
+void remplir_stations(t_terrain *terrain, uint64_t graine)
+{
+  t_alea alea;
+  alea_init(&alea, graine);
+  for (int i = 0; i < terrain->nb_lignes; i++)
+  {
+    for (int j = 0; j < terrain->nb_colonnes; j++)
+    {
+      terrain->cases[terrain_indice(terrain, i, j)] = alea_borne(&alea, 3) == 0 ? (uint8_t)alea_entre(&alea, 1, STATION_MAX_CARBURANT) : 0;
+    }
+  }
+}
+
+double mesurer_requetes(const t_terrain *terrain, t_dijkstra_moteur moteur, int *cout)
+{
+  // Le contexte est cree hors mesure, et une premiere requete le met en cache comme dans une partie
+  t_dijkstra_contexte *contexte = dijkstra_contexte_creer(terrain);
+  if (contexte == NULL)
+  {
+    return -1;
+  }
+  dijkstra_contexte_choisir_moteur(contexte, moteur);
+  int dernier = terrain->nb_lignes - 1;
+  *cout = dijkstra_calculer_cout(contexte, terrain, 0, 0, dernier, terrain->nb_colonnes - 1, NULL);
+
+  double debut = instant_ms();
+  for (int r = 0; r < NB_REQUETES; r++)
+  {
+    // Coins alternes : de haut en bas puis de bas en haut
+    int depart_ligne = r % 2 == 0 ? 0 : dernier;
+    *cout = dijkstra_calculer_cout(contexte, terrain, depart_ligne, 0, dernier - depart_ligne, terrain->nb_colonnes - 1, NULL);
+  }
+  double duree = (instant_ms() - debut) / NB_REQUETES;
+  dijkstra_contexte_detruire(contexte);
+  return duree;
+}
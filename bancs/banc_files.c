@@ -0,0 +1,189 @@
+// Banc d'essai des files de priorite de l'algorithme de Dijkstra : balayage lineaire (la version
+// d'origine, reprise ici), tas d-aire et seaux de Dial, sur des terrains carres de plus en plus grands.
+// Chaque requete va d'un coin au coin oppose ; les couts des trois versions doivent etre identiques.
+//
+// Compilation, depuis ce dossier :
+//   gcc -O2 -std=c11 -I.. banc_files.c $(ls ../*.c | grep -v main.c) -pthread -o banc_files
+// Utilisation : ./banc_files [graine]
+#define _POSIX_C_SOURCE 200809L // Pour clock_gettime
+#include "alea.h"
+#include "dijkstra.h"
+#include "terrain.h"
+#include <limits.h>
+#include <stdbool.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <time.h>
+
+// Cote du plus grand terrain sur lequel le balayage lineaire, en O(V^2), est encore mesure
+#define COTE_MAX_BALAYAGE 200
+
+// Nombre de requetes mesurees par terrain et par file
+#define NB_REQUETES 3
+
+/**
+ * @brief Donne le temps ecoule depuis une origine fixe, en millisecondes.
+ * @name maintenant
+ * @return le temps en millisecondes
+ */
+double maintenant(void);
+
+/**
+ * @brief Remplit un terrain d'un tiers de stations au carburant tire au hasard.
+ * @name remplir_terrain
+ * @param terrain le terrain
+ * @param alea le generateur
+ */
+void remplir_terrain(t_terrain *terrain, t_alea *alea);
+
+/**
+ * @brief Algorithme de Dijkstra d'origine : la case suivante est cherchee par un parcours de tout le terrain.
+ * @name cout_balayage
+ * @param terrain le terrain
+ * @param depart l'indice de la case de depart
+ * @param destination l'indice de la case a atteindre
+ * @return le cout du plus court chemin, -1 si la destination est inaccessible ou si la memoire manque
+ */
+int cout_balayage(const t_terrain *terrain, int depart, int destination);
+
+int main(int argc, char *argv[])
+{
+  static const int cotes[] = {100, 200, 1000, 2000, 4000};
+  t_alea alea;
+  alea_init(&alea, argc > 1 ? strtoull(argv[1], NULL, 10) : 1);
+
+  printf("%8s %12s %12s %12s %8s\n", "cote", "balayage ms", "tas ms", "seaux ms", "couts");
+  for (size_t k = 0; k < sizeof(cotes) / sizeof(cotes[0]); k++)
+  {
+    int cote = cotes[k];
+    t_terrain *terrain = terrain_creer(cote, cote);
+    t_dijkstra_contexte *contextes[2] = {NULL, NULL};
+    if (terrain == NULL)
+    {
+      printf("Memoire insuffisante pour un terrain de %d x %d\n", cote, cote);
+      return 1;
+    }
+    remplir_terrain(terrain, &alea);
+
+    // Un contexte par file, cree avant la mesure : seul le calcul est chronometre
+    const t_dijkstra_moteur moteurs[2] = {DIJKSTRA_MOTEUR_TAS, DIJKSTRA_MOTEUR_SEAUX};
+    double temps[3] = {0, 0, 0};
+    int couts[3] = {-1, -1, -1};
+    bool identiques = true;
+    for (int m = 0; m < 2; m++)
+    {
+      contextes[m] = dijkstra_contexte_creer(terrain);
+      if (contextes[m] == NULL)
+      {
+        printf("Memoire insuffisante pour un contexte de %d x %d\n", cote, cote);
+        return 1;
+      }
+      dijkstra_contexte_choisir_moteur(contextes[m], moteurs[m]);
+    }
+
+    for (int r = 0; r < NB_REQUETES; r++)
+    {
+      // Coins alternes pour que chaque requete parcoure tout le terrain
+      int depart_ligne = r % 2 == 0 ? 0 : cote - 1;
+      int destination_ligne = cote - 1 - depart_ligne;
+      int depart_colonne = r < 2 ? 0 : cote - 1;
+      int destination_colonne = cote - 1 - depart_colonne;
+
+      if (cote <= COTE_MAX_BALAYAGE)
+      {
+        double debut = maintenant();
+        couts[0] = cout_balayage(terrain, terrain_indice(terrain, depart_ligne, depart_colonne), terrain_indice(terrain, destination_ligne, destination_colonne));
+        temps[0] += maintenant() - debut;
+      }
+      for (int m = 0; m < 2; m++)
+      {
+        double debut = maintenant();
+        couts[m + 1] = dijkstra_calculer_cout(contextes[m], terrain, depart_ligne, depart_colonne, destination_ligne, destination_colonne, NULL);
+        temps[m + 1] += maintenant() - debut;
+      }
+      identiques = identiques && couts[1] == couts[2] && (cote > COTE_MAX_BALAYAGE || couts[0] == couts[1]);
+    }
+
+    char balayage[16] = "-";
+    if (cote <= COTE_MAX_BALAYAGE)
+    {
+      snprintf(balayage, sizeof(balayage), "%.2f", temps[0] / NB_REQUETES);
+    }
+    printf("%8d %12s %12.2f %12.2f %8s\n", cote, balayage, temps[1] / NB_REQUETES, temps[2] / NB_REQUETES, identiques ? "egaux" : "ECART");
+    dijkstra_contexte_detruire(contextes[0]);
+    dijkstra_contexte_detruire(contextes[1]);
+    terrain_detruire(terrain);
+    if (!identiques)
+    {
+      return 1;
+    }
+  }
+  return 0;
+}
+
+double maintenant(void)
+{
+  struct timespec instant;
+  clock_gettime(CLOCK_MONOTONIC, &instant);
+  return (double)instant.tv_sec * 1e3 + (double)instant.tv_nsec / 1e6;
+}
+
+void remplir_terrain(t_terrain *terrain, t_alea *alea)
+{
+  for (int i = 0; i < terrain->nb_lignes; i++)
+  {
+    for (int j = 0; j < terrain->nb_colonnes; j++)
+    {
+      terrain->cases[terrain_indice(terrain, i, j)] = alea_borne(alea, 3) == 0 ? (uint8_t)alea_entre(alea, 1, STATION_MAX_CARBURANT) : 0;
+    }
+  }
+}
+
+int cout_balayage(const t_terrain *terrain, int depart, int destination)
+{
+  int *couts = malloc((size_t)terrain->nb_cases * sizeof(int));
+  bool *visitees = calloc((size_t)terrain->nb_cases, sizeof(bool));
+  int cout = -1;
+  if (couts != NULL && visitees != NULL)
+  {
+    for (int indice = 0; indice < terrain->nb_cases; indice++)
+    {
+      couts[indice] = INT_MAX;
+    }
+    couts[depart] = 0;
+    while (true)
+    {
+      // La case non visitee de plus petit cout, cherchee sur tout le terrain
+      int choisie = -1;
+      for (int i = 0; i < terrain->nb_lignes; i++)
+      {
+        for (int j = 0; j < terrain->nb_colonnes; j++)
+        {
+          int indice = terrain_indice(terrain, i, j);
+          if (!visitees[indice] && couts[indice] != INT_MAX && (choisie == -1 || couts[indice] < couts[choisie]))
+          {
+            choisie = indice;
+          }
+        }
+      }
+      if (choisie == -1 || choisie == destination)
+      {
+        break;
+      }
+      visitees[choisie] = true;
+      for (t_direction direction = DIRECTION_DROITE; direction <= DIRECTION_GAUCHE; direction++)
+      {
+        int voisin = TERRAIN_VOISINE(terrain, choisie, direction);
+        if (terrain->cases[voisin] != TERRAIN_BORDURE && !visitees[voisin] &&
+            couts[choisie] + 1 + (STATION_MAX_CARBURANT - terrain->cases[voisin]) < couts[voisin])
+        {
+          couts[voisin] = couts[choisie] + 1 + (STATION_MAX_CARBURANT - terrain->cases[voisin]);
+        }
+      }
+    }
+    cout = couts[destination] == INT_MAX ? -1 : couts[destination];
+  }
+  free(couts);
+  free(visitees);
+  return cout;
+}
@@ -0,0 +1,111 @@
+// Test du balayage : sur des terrains tires au hasard, le cout de chaque case depuis la source doit etre
+// celui que donne dijkstra_calculer_cout. Les largeurs de 1 a 2 * 8 colonnes sont toutes essayees, pour
+// que les colonnes de remplissage des vecteurs (jusqu'au multiple de 8 ou de 4) soient toujours
+// exercees ; une source hors du terrain doit etre refusee.
+// Le noyau est choisi a la compilation : le test se compile une fois par noyau.
+//
+// Compilation, depuis ce dossier :
+//   gcc -O2 -std=c11 -I.. test_balayage.c $(ls ../*.c | grep -v main.c) -pthread -o test_balayage
+//   gcc -O2 -std=c11 -msse4.1 -I.. test_balayage.c $(ls ../*.c | grep -v main.c) -pthread -o test_balayage_sse
+//   gcc -O2 -std=c11 -mavx2 -I.. test_balayage.c $(ls ../*.c | grep -v main.c) -pthread -o test_balayage_avx2
+// Utilisation : ./test_balayage [graine]
+#include "alea.h"
+#include "balayage.h"
+#include "dijkstra.h"
+#include "terrain.h"
+#include <limits.h>
+#include <stdio.h>
+#include <stdlib.h>
+
+// Nombre de terrains tires
+#define NB_TERRAINS 300
+
+// Cote maximal des terrains tires
+#define COTE_MAX 40
+
+// Nombre de terrains dont la largeur est imposee : 1, 2... LARGEURS_IMPOSEES colonnes
+#define LARGEURS_IMPOSEES 16
+
+/**
+ * @brief Remplit un terrain de stations, avec une densite tiree au hasard pour varier les terrains
+ * presque vides, ou tous les couts d'entree sont au plus haut, et les terrains presque pleins.
+ * @name remplir_terrain_balayage
+ * @param terrain le terrain
+ * @param alea le generateur
+ */
+void remplir_terrain_balayage(t_terrain *terrain, t_alea *alea);
+
+int main(int argc, char *argv[])
+{
+  t_alea alea;
+  alea_init(&alea, argc > 1 ? strtoull(argv[1], NULL, 10) : 1);
+  int nb_cases = 0;
+  int nb_ecarts = 0;
+  printf("Noyau : %s\n", BALAYAGE_LARGEUR_VECTEUR == 8 ? "AVX2" : BALAYAGE_LARGEUR_VECTEUR == 4 ? "SSE4.1" : "scalaire");
+
+  for (int t = 0; t < NB_TERRAINS; t++)
+  {
+    int nb_lignes = alea_entre(&alea, 1, COTE_MAX);
+    int nb_colonnes = t < LARGEURS_IMPOSEES ? t + 1 : alea_entre(&alea, 1, COTE_MAX);
+    t_terrain *terrain = terrain_creer(nb_lignes, nb_colonnes);
+    t_dijkstra_contexte *contexte = terrain == NULL ? NULL : dijkstra_contexte_creer(terrain);
+    int *couts = terrain == NULL ? NULL : malloc((size_t)terrain->nb_cases * sizeof(int));
+    if (contexte == NULL || couts == NULL)
+    {
+      printf("Memoire insuffisante pour un terrain de %d x %d\n", nb_lignes, nb_colonnes);
+      dijkstra_contexte_detruire(contexte);
+      terrain_detruire(terrain);
+      return 1;
+    }
+    remplir_terrain_balayage(terrain, &alea);
+
+    int source_ligne = (int)alea_borne(&alea, (uint32_t)nb_lignes);
+    int source_colonne = (int)alea_borne(&alea, (uint32_t)nb_colonnes);
+    if (balayage_calculer_couts(terrain, nb_lignes, source_colonne, couts, NULL) ||
+        balayage_calculer_couts(terrain, source_ligne, -1, couts, NULL))
+    {
+      nb_ecarts++;
+      printf("Source hors d'un terrain de %d x %d acceptee\n", nb_lignes, nb_colonnes);
+    }
+    if (!balayage_calculer_couts(terrain, source_ligne, source_colonne, couts, NULL))
+    {
+      printf("Memoire insuffisante pour le balayage d'un terrain de %d x %d\n", nb_lignes, nb_colonnes);
+      return 1;
+    }
+
+    // Toutes les cases sont accessibles : aucune ne doit rester a INT_MAX, ni deborder
+    for (int i = 0; i < nb_lignes; i++)
+    {
+      for (int j = 0; j < nb_colonnes; j++)
+      {
+        int cout_balayage = couts[terrain_indice(terrain, i, j)];
+        int cout_dijkstra = dijkstra_calculer_cout(contexte, terrain, source_ligne, source_colonne, i, j, NULL);
+        nb_cases++;
+        if (cout_balayage != cout_dijkstra)
+        {
+          nb_ecarts++;
+          printf("Ecart sur un terrain de %d x %d, de (%d, %d) a (%d, %d) : balayage %d, dijkstra %d\n",
+                 nb_lignes, nb_colonnes, source_ligne, source_colonne, i, j, cout_balayage, cout_dijkstra);
+        }
+      }
+    }
+    free(couts);
+    dijkstra_contexte_detruire(contexte);
+    terrain_detruire(terrain);
+  }
+
+  printf("%d cases sur %d terrains, %d ecarts\n", nb_cases, NB_TERRAINS, nb_ecarts);
+  return nb_ecarts == 0 ? 0 : 1;
+}
+
+void remplir_terrain_balayage(t_terrain *terrain, t_alea *alea)
+{
+  uint32_t densite = (uint32_t)alea_entre(alea, 1, 10); // Une case sur densite est une station
+  for (int i = 0; i < terrain->nb_lignes; i++)
+  {
+    for (int j = 0; j < terrain->nb_colonnes; j++)
+    {
+      terrain->cases[terrain_indice(terrain, i, j)] = alea_borne(alea, densite) == 0 ? (uint8_t)alea_entre(alea, 1, STATION_MAX_CARBURANT) : 0;
+    }
+  }
+}
@@ -0,0 +1,104 @@
+// Test de la recherche bidirectionnelle : sur des terrains tires au hasard, de toutes les formes (une
+// seule ligne, une seule colonne, carres, allonges), le cout qu'elle donne doit etre celui du tas.
+// Les requetes relient des cases quelconques, et toujours un coin au coin oppose et une case a elle-meme.
+//
+// Compilation, depuis ce dossier :
+//   gcc -O2 -std=c11 -I.. test_bidirectionnel.c $(ls ../*.c | grep -v main.c) -pthread -o test_bidirectionnel
+// Utilisation : ./test_bidirectionnel [graine]
+#include "alea.h"
+#include "dijkstra.h"
+#include "terrain.h"
+#include <stdio.h>
+#include <stdlib.h>
+
+// Nombre de terrains tires
+#define NB_TERRAINS 500
+
+// Nombre de requetes par terrain
+#define NB_REQUETES_PAR_TERRAIN 40
+
+// Cote maximal des terrains tires
+#define COTE_MAX 60
+
+/**
+ * @brief Remplit un terrain de stations, avec une densite tiree au hasard pour varier les terrains
+ * presque vides, ou le plus court chemin est souvent ambigu, et les terrains presque pleins.
+ * @name remplir_terrain_melange
+ * @param terrain le terrain
+ * @param alea le generateur
+ */
+void remplir_terrain_melange(t_terrain *terrain, t_alea *alea);
+
+int main(int argc, char *argv[])
+{
+  t_alea alea;
+  alea_init(&alea, argc > 1 ? strtoull(argv[1], NULL, 10) : 1);
+  int nb_requetes = 0;
+  int nb_ecarts = 0;
+
+  for (int t = 0; t < NB_TERRAINS; t++)
+  {
+    int nb_lignes = alea_entre(&alea, 1, COTE_MAX);
+    int nb_colonnes = alea_entre(&alea, 1, COTE_MAX);
+    t_terrain *terrain = terrain_creer(nb_lignes, nb_colonnes);
+    t_dijkstra_contexte *contexte = terrain == NULL ? NULL : dijkstra_contexte_creer(terrain);
+    if (contexte == NULL)
+    {
+      printf("Memoire insuffisante pour un terrain de %d x %d\n", nb_lignes, nb_colonnes);
+      terrain_detruire(terrain);
+      return 1;
+    }
+    remplir_terrain_melange(terrain, &alea);
+
+    for (int r = 0; r < NB_REQUETES_PAR_TERRAIN; r++)
+    {
+      int depart_ligne = (int)alea_borne(&alea, (uint32_t)nb_lignes);
+      int depart_colonne = (int)alea_borne(&alea, (uint32_t)nb_colonnes);
+      int destination_ligne = (int)alea_borne(&alea, (uint32_t)nb_lignes);
+      int destination_colonne = (int)alea_borne(&alea, (uint32_t)nb_colonnes);
+      if (r == 0)
+      {
+        // Toujours un coin a l'autre, la requete la plus longue du terrain
+        depart_ligne = depart_colonne = 0;
+        destination_ligne = nb_lignes - 1;
+        destination_colonne = nb_colonnes - 1;
+      }
+      else if (r == 1)
+      {
+        // Toujours une case a elle-meme
+        destination_ligne = depart_ligne;
+        destination_colonne = depart_colonne;
+      }
+
+      // Le meme contexte sert aux deux moteurs, comme dans le jeu : l'un ne doit pas fausser l'autre
+      dijkstra_contexte_choisir_moteur(contexte, DIJKSTRA_MOTEUR_TAS);
+      int cout_tas = dijkstra_calculer_cout(contexte, terrain, depart_ligne, depart_colonne, destination_ligne, destination_colonne, NULL);
+      dijkstra_contexte_choisir_moteur(contexte, DIJKSTRA_MOTEUR_BIDIRECTIONNEL);
+      int cout_bidirectionnel = dijkstra_calculer_cout(contexte, terrain, depart_ligne, depart_colonne, destination_ligne, destination_colonne, NULL);
+      nb_requetes++;
+      if (cout_tas != cout_bidirectionnel)
+      {
+        nb_ecarts++;
+        printf("Ecart sur un terrain de %d x %d, de (%d, %d) a (%d, %d) : tas %d, bidirectionnel %d\n",
+               nb_lignes, nb_colonnes, depart_ligne, depart_colonne, destination_ligne, destination_colonne, cout_tas, cout_bidirectionnel);
+      }
+    }
+    dijkstra_contexte_detruire(contexte);
+    terrain_detruire(terrain);
+  }
+
+  printf("%d requetes sur %d terrains, %d ecarts\n", nb_requetes, NB_TERRAINS, nb_ecarts);
+  return nb_ecarts == 0 ? 0 : 1;
+}
+
+void remplir_terrain_melange(t_terrain *terrain, t_alea *alea)
+{
+  uint32_t densite = (uint32_t)alea_entre(alea, 1, 10); // Une case sur densite est une station
+  for (int i = 0; i < terrain->nb_lignes; i++)
+  {
+    for (int j = 0; j < terrain->nb_colonnes; j++)
+    {
+      terrain->cases[terrain_indice(terrain, i, j)] = alea_borne(alea, densite) == 0 ? (uint8_t)alea_entre(alea, 1, STATION_MAX_CARBURANT) : 0;
+    }
+  }
+}
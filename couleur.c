@@ -5,6 +5,14 @@
 
 #define ESCAPE "\033["
 
+/**
+ * @brief Ecrit un code de 0 a 999 en decimal, sans zero de tete.
+ * @param tampon le tampon ou ecrire
+ * @param code le code a ecrire
+ * @return le nombre de chiffres ecrits
+ */
+int couleur_ecrire_code(char tampon[], int code);
+
 void couleur_set(int style, int couleur_avant_plan, int couleur_arriere_plan)
 {
     printf("%s%d;%d;%dm", ESCAPE, style, couleur_avant_plan, couleur_arriere_plan);
@@ -12,5 +20,34 @@ void couleur_set(int style, int couleur_avant_plan, int couleur_arriere_plan)
 
 void couleur_reset(void)
 {
-    printf("%s0m", ESCAPE);
+    printf("%s", COULEUR_RESET);
+}
+
+int couleur_formater(char tampon[], int style, int couleur_avant_plan, int couleur_arriere_plan)
+{
+    int n = 0;
+    tampon[n++] = '\033';
+    tampon[n++] = '[';
+    n += couleur_ecrire_code(&tampon[n], style);
+    tampon[n++] = ';';
+    n += couleur_ecrire_code(&tampon[n], couleur_avant_plan);
+    tampon[n++] = ';';
+    n += couleur_ecrire_code(&tampon[n], couleur_arriere_plan);
+    tampon[n++] = 'm';
+    return n;
+}
+
+int couleur_ecrire_code(char tampon[], int code)
+{
+    int n = 0;
+    if (code >= 100)
+    {
+        tampon[n++] = (char)('0' + code / 100);
+    }
+    if (code >= 10)
+    {
+        tampon[n++] = (char)('0' + code / 10 % 10);
+    }
+    tampon[n++] = (char)('0' + code % 10);
+    return n;
 }
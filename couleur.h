@@ -52,6 +52,12 @@
 #define BG_BRIGHT_CYAN 106
 #define BG_BRIGHT_WHITE 107
 
+// Sequence qui remet le style et les couleurs par defaut
+#define COULEUR_RESET "\033[0m"
+
+// Longueur maximale d'une sequence ecrite par couleur_formater, codes de 0 a 999
+#define COULEUR_TAILLE_MAX 15
+
 /**
  * @brief Specifie un style, une couleur de fond et une couleur d'avant-plan pour les
  * caracteres affiches dans la console.
@@ -67,4 +73,15 @@ void couleur_set(int style, int couleur_avant_plan, int couleur_arriere_plan);
  */
 void couleur_reset(void);
 
+/**
+ * @brief Ecrit dans un tampon, sans l'afficher, la sequence qui specifie un style, une couleur
+ * d'avant-plan et une couleur d'arriere-plan. Le tampon n'est pas termine par un zero.
+ * @param tampon le tampon ou ecrire, d'au moins COULEUR_TAILLE_MAX caracteres
+ * @param style le style de caractere
+ * @param couleur_avant_plan la couleur d'avant-plan
+ * @param couleur_arriere_plan la couleur d'arriere-plan
+ * @return le nombre de caracteres ecrits
+ */
+int couleur_formater(char tampon[], int style, int couleur_avant_plan, int couleur_arriere_plan);
+
 #endif // DIJKSTRA_COULEURS_H
@@ -0,0 +1,465 @@
+// Les barrieres de fils sont une extension POSIX que -std=c11 masque sinon
+#define _POSIX_C_SOURCE 200809L
+
+#include "delta.h"
+#include "seaux.h" // Pour le type t_seau
+#include <limits.h>
+#include <pthread.h>
+#include <stdatomic.h>
+#include <stdlib.h>
+
+// ****************************
+// Definitions des types prives
+// ****************************
+typedef struct s_etalement t_etalement;
+
+// Type pour un fil de calcul et ses seaux
+typedef struct
+{
+  pthread_t identifiant;  // L'identifiant du fil
+  int numero;             // Le rang du fil, 0 pour le fil appelant
+  t_etalement *etalement; // Le calcul auquel participe le fil
+  t_seau *seaux;          // Les seaux du fil, en tableau circulaire de nb_seaux seaux
+  t_seau en_cours;        // Les cases du seau courant tirees des seaux du fil, que tous les fils se partagent
+  t_seau reglees;         // Les cases que le fil a tirees du seau courant, pour les deplacements lourds
+} t_ouvrier;
+
+// Type pour l'etat partage par les fils d'un calcul
+struct s_etalement
+{
+  const t_terrain *terrain;   // Le terrain, en lecture seule
+  int largeur_seau;           // La largeur des seaux, qui separe aussi deplacements legers et lourds
+  int nb_seaux;               // Le nombre de seaux de chaque fil
+  t_ouvrier *ouvriers;        // Tous les fils du calcul, dont les cases en cours sont partagees
+  int nb_fils;                // Le nombre de fils du calcul
+  atomic_int *couts;          // Le meilleur cout connu de chaque case, INT_MAX si aucun
+  atomic_int *traites;        // Le cout avec lequel chaque case a ete developpee en dernier, -1 si jamais
+  pthread_mutex_t depart;     // Tenu par le fil appelant tant que tous les fils ne sont pas demarres
+  bool annule;                // Indique qu'un fil n'a pas pu etre demarre et que le calcul n'aura pas lieu
+  pthread_barrier_t barriere; // Separe les tours de calcul
+  atomic_int prochains[3];    // Le plus petit seau non vide propose a chaque tour, par rotation de trois
+  atomic_bool encore[3];      // Indique a chaque tour qu'un fil a encore des cases dans le seau courant
+  atomic_int curseurs[3];     // A chaque tour, le nombre de cases en cours deja distribuees aux fils
+  atomic_bool echec;          // Indique qu'un fil a manque de memoire
+};
+
+// Cout maximal d'un deplacement vers une case voisine (case sans carburant)
+#define COUT_DEPLACEMENT_MAX (1 + STATION_MAX_CARBURANT)
+
+// Nombre de cases en cours qu'un fil prend d'un coup : assez pour amortir l'echange atomique,
+// assez peu pour que les fils finissent ensemble
+#define TAILLE_LOT 64
+
+// **********************************
+// Declarations des fonctions privees
+// **********************************
+/**
+ * @brief Boucle d'un fil : a chaque tour, choisit avec les autres fils le plus petit seau non vide,
+ * le vide par deplacements legers jusqu'a ce qu'aucun fil n'y ait plus de case, puis relache les
+ * deplacements lourds des cases reglees. A chaque passe, chaque fil met de cote ses cases du seau,
+ * puis tous les fils se partagent par lots l'ensemble de ces cases : le travail est reparti meme
+ * quand un seul fil a rempli le seau.
+ * @name parcourir_seaux
+ * @param argument le fil (t_ouvrier *)
+ * @return NULL
+ */
+void *parcourir_seaux(void *argument);
+
+/**
+ * @brief Attend les autres fils a la fin d'un tour. Le fil 0 remet ensuite a zero les indicateurs
+ * du tour tour + 2 : ceux du tour precedent ont tous ete lus avant cette barriere et ceux du tour
+ * tour + 2 ne seront ecrits qu'apres la suivante, ce qui evite une seconde barriere par tour.
+ * @name franchir_barriere
+ * @param ouvrier le fil
+ * @param tour le numero du tour qui se termine
+ */
+void franchir_barriere(t_ouvrier *ouvrier, int tour);
+
+/**
+ * @brief Abaisse atomiquement une valeur partagee a un minimum.
+ * @name proposer_minimum
+ * @param valeur la valeur partagee
+ * @param proposition la valeur proposee
+ * @return true si la proposition a remplace la valeur, false si la valeur etait deja inferieure ou egale
+ */
+bool proposer_minimum(atomic_int *valeur, int proposition);
+
+/**
+ * @brief Cherche le plus petit seau non vide d'un fil.
+ * @name plus_petit_seau
+ * @param ouvrier le fil
+ * @param seau le dernier seau traite, sous lequel il ne reste plus de case
+ * @return le numero du seau, INT_MAX si tous les seaux du fil sont vides
+ */
+int plus_petit_seau(const t_ouvrier *ouvrier, int seau);
+
+/**
+ * @brief Met de cote les cases qu'un fil a dans le seau courant, pour que tous les fils se les partagent.
+ * Les cases qui reviennent dans le seau pendant leur traitement attendront la passe suivante.
+ * @name prendre_seau_courant
+ * @param ouvrier le fil
+ * @param seau le seau courant
+ */
+void prendre_seau_courant(t_ouvrier *ouvrier, int seau);
+
+/**
+ * @brief Prend des lots de cases mises de cote par tous les fils, tant qu'il en reste, et les
+ * developpe en relachant leurs deplacements legers. Les cases deja developpees avec le meme cout,
+ * par ce fil ou un autre, sont ignorees ; les cases reglees et celles atteintes vont dans les seaux du fil.
+ * @name vider_seau_leger
+ * @param ouvrier le fil
+ * @param seau le seau courant
+ * @param curseur le nombre de cases deja distribuees pendant ce tour
+ */
+void vider_seau_leger(t_ouvrier *ouvrier, int seau, atomic_int *curseur);
+
+/**
+ * @brief Relache les deplacements lourds des cases qu'un fil a tirees du seau courant, dont les couts sont definitifs.
+ * @name relacher_lourds
+ * @param ouvrier le fil
+ */
+void relacher_lourds(t_ouvrier *ouvrier);
+
+/**
+ * @brief Relache les deplacements legers ou lourds depuis une case vers ses voisines.
+ * @name relacher_voisins
+ * @param ouvrier le fil
+ * @param indice l'indice de la case
+ * @param cout le cout de la case
+ * @param legers true pour les deplacements legers, false pour les lourds
+ */
+void relacher_voisins(t_ouvrier *ouvrier, int indice, int cout, bool legers);
+
+/**
+ * @brief Ajoute une case a un seau en agrandissant le seau si besoin.
+ * @name empiler_case
+ * @param seau le seau
+ * @param indice l'indice de la case
+ * @return true si l'ajout a reussi, false si la memoire manque
+ */
+bool empiler_case(t_seau *seau, int indice);
+
+/**
+ * @brief Libere les seaux d'un fil.
+ * @name liberer_ouvrier
+ * @param ouvrier le fil
+ * @param nb_seaux le nombre de seaux du fil
+ */
+void liberer_ouvrier(t_ouvrier *ouvrier, int nb_seaux);
+
+// ***********************************
+// Definitions des fonctions publiques
+// ***********************************
+bool delta_calculer_couts(const t_terrain *terrain, int source_ligne, int source_colonne, int largeur_seau, int nb_fils, int couts[])
+{
+  if (largeur_seau < 1 || nb_fils < 1 || !terrain_contient(terrain, source_ligne, source_colonne))
+  {
+    return false;
+  }
+
+  int nb_cases = terrain->nb_cases;
+  t_etalement etalement;
+  etalement.terrain = terrain;
+  etalement.largeur_seau = largeur_seau;
+  // Un deplacement depuis le seau courant mene au plus COUT_DEPLACEMENT_MAX / largeur_seau + 1 seaux plus loin
+  etalement.nb_seaux = COUT_DEPLACEMENT_MAX / largeur_seau + 2;
+  etalement.nb_fils = nb_fils;
+  etalement.couts = malloc((size_t)nb_cases * sizeof(atomic_int));
+  etalement.traites = malloc((size_t)nb_cases * sizeof(atomic_int));
+  t_ouvrier *ouvriers = calloc((size_t)nb_fils, sizeof(t_ouvrier));
+  etalement.ouvriers = ouvriers;
+  bool alloue = etalement.couts != NULL && etalement.traites != NULL && ouvriers != NULL;
+  for (int i = 0; alloue && i < nb_fils; i++)
+  {
+    ouvriers[i].numero = i;
+    ouvriers[i].etalement = &etalement;
+    ouvriers[i].seaux = calloc((size_t)etalement.nb_seaux, sizeof(t_seau));
+    alloue = ouvriers[i].seaux != NULL;
+  }
+  int source = terrain_indice(terrain, source_ligne, source_colonne);
+  if (!alloue || !empiler_case(&ouvriers[0].seaux[0], source))
+  {
+    for (int i = 0; ouvriers != NULL && i < nb_fils; i++)
+    {
+      liberer_ouvrier(&ouvriers[i], etalement.nb_seaux);
+    }
+    free(ouvriers);
+    free(etalement.traites);
+    free(etalement.couts);
+    return false;
+  }
+
+  for (int i = 0; i < nb_cases; i++)
+  {
+    atomic_init(&etalement.couts[i], INT_MAX);
+    atomic_init(&etalement.traites[i], -1);
+  }
+  atomic_store(&etalement.couts[source], 0);
+  for (int i = 0; i < 3; i++)
+  {
+    atomic_init(&etalement.prochains[i], INT_MAX);
+    atomic_init(&etalement.encore[i], false);
+    atomic_init(&etalement.curseurs[i], 0);
+  }
+  atomic_init(&etalement.echec, false);
+  etalement.annule = false;
+  pthread_mutex_init(&etalement.depart, NULL);
+  pthread_barrier_init(&etalement.barriere, NULL, (unsigned)nb_fils);
+
+  // Le fil appelant fait office de fil 0 ; les autres attendent qu'il ait demarre tout le monde
+  pthread_mutex_lock(&etalement.depart);
+  int nb_demarres = 1;
+  while (nb_demarres < nb_fils &&
+         pthread_create(&ouvriers[nb_demarres].identifiant, NULL, parcourir_seaux, &ouvriers[nb_demarres]) == 0)
+  {
+    nb_demarres++;
+  }
+  etalement.annule = nb_demarres < nb_fils;
+  pthread_mutex_unlock(&etalement.depart);
+
+  if (!etalement.annule)
+  {
+    parcourir_seaux(&ouvriers[0]);
+  }
+  for (int i = 1; i < nb_demarres; i++)
+  {
+    pthread_join(ouvriers[i].identifiant, NULL);
+  }
+
+  bool reussi = !etalement.annule && !atomic_load(&etalement.echec);
+  for (int i = 0; reussi && i < nb_cases; i++)
+  {
+    couts[i] = atomic_load(&etalement.couts[i]);
+  }
+
+  pthread_barrier_destroy(&etalement.barriere);
+  pthread_mutex_destroy(&etalement.depart);
+  for (int i = 0; i < nb_fils; i++)
+  {
+    liberer_ouvrier(&ouvriers[i], etalement.nb_seaux);
+  }
+  free(ouvriers);
+  free(etalement.traites);
+  free(etalement.couts);
+  return reussi;
+}
+
+// *********************************
+// Definitions des fonctions privees
+// *********************************
+void *parcourir_seaux(void *argument)
+{
+  t_ouvrier *ouvrier = argument;
+  t_etalement *etalement = ouvrier->etalement;
+
+  pthread_mutex_lock(&etalement->depart);
+  pthread_mutex_unlock(&etalement->depart);
+  if (etalement->annule)
+  {
+    return NULL;
+  }
+
+  int tour = 0;
+  int seau = 0;
+  while (true)
+  {
+    proposer_minimum(&etalement->prochains[tour % 3], plus_petit_seau(ouvrier, seau));
+    franchir_barriere(ouvrier, tour);
+    seau = atomic_load(&etalement->prochains[tour % 3]);
+    tour++;
+    if (seau == INT_MAX)
+    {
+      break;
+    }
+
+    // Un deplacement leger peut ramener une case dans le seau courant : on recommence tant qu'un fil en a
+    ouvrier->reglees.taille = 0;
+    bool encore;
+    do
+    {
+      prendre_seau_courant(ouvrier, seau);
+      franchir_barriere(ouvrier, tour);
+      tour++;
+      vider_seau_leger(ouvrier, seau, &etalement->curseurs[tour % 3]);
+      if (ouvrier->seaux[seau % etalement->nb_seaux].taille > 0)
+      {
+        atomic_store(&etalement->encore[tour % 3], true);
+      }
+      franchir_barriere(ouvrier, tour);
+      encore = atomic_load(&etalement->encore[tour % 3]);
+      tour++;
+    } while (encore);
+
+    // Les couts du seau sont definitifs ; les cases atteintes par un deplacement lourd tombent dans un seau suivant
+    relacher_lourds(ouvrier);
+  }
+  return NULL;
+}
+
+void franchir_barriere(t_ouvrier *ouvrier, int tour)
+{
+  t_etalement *etalement = ouvrier->etalement;
+  pthread_barrier_wait(&etalement->barriere);
+  if (ouvrier->numero == 0)
+  {
+    atomic_store(&etalement->prochains[(tour + 2) % 3], INT_MAX);
+    atomic_store(&etalement->encore[(tour + 2) % 3], false);
+    atomic_store(&etalement->curseurs[(tour + 2) % 3], 0);
+  }
+}
+
+bool proposer_minimum(atomic_int *valeur, int proposition)
+{
+  int actuelle = atomic_load(valeur);
+  while (proposition < actuelle)
+  {
+    if (atomic_compare_exchange_weak(valeur, &actuelle, proposition))
+    {
+      return true;
+    }
+  }
+  return false;
+}
+
+int plus_petit_seau(const t_ouvrier *ouvrier, int seau)
+{
+  int nb_seaux = ouvrier->etalement->nb_seaux;
+  for (int i = 0; i < nb_seaux; i++)
+  {
+    if (ouvrier->seaux[(seau + i) % nb_seaux].taille > 0)
+    {
+      return seau + i;
+    }
+  }
+  return INT_MAX;
+}
+
+void prendre_seau_courant(t_ouvrier *ouvrier, int seau)
+{
+  // Le seau courant est echange avec en_cours, vide depuis la passe precedente
+  t_seau *courant = &ouvrier->seaux[seau % ouvrier->etalement->nb_seaux];
+  t_seau echange = *courant;
+  *courant = ouvrier->en_cours;
+  courant->taille = 0;
+  ouvrier->en_cours = echange;
+}
+
+void vider_seau_leger(t_ouvrier *ouvrier, int seau, atomic_int *curseur)
+{
+  t_etalement *etalement = ouvrier->etalement;
+
+  // Les cases en cours de tous les fils sont numerotees a la suite, fil par fil ; un lot peut
+  // ainsi s'etendre sur les cases de plusieurs fils
+  while (true)
+  {
+    int debut = atomic_fetch_add(curseur, TAILLE_LOT);
+    int fil = 0;
+    int decalage = debut;
+    while (fil < etalement->nb_fils && decalage >= etalement->ouvriers[fil].en_cours.taille)
+    {
+      decalage -= etalement->ouvriers[fil].en_cours.taille;
+      fil++;
+    }
+    if (fil == etalement->nb_fils)
+    {
+      break;
+    }
+
+    for (int n = 0; n < TAILLE_LOT && fil < etalement->nb_fils; n++)
+    {
+      const t_seau *en_cours = &etalement->ouvriers[fil].en_cours;
+      int indice = en_cours->indices[decalage];
+      if (++decalage == en_cours->taille)
+      {
+        decalage = 0;
+        fil++;
+        while (fil < etalement->nb_fils && etalement->ouvriers[fil].en_cours.taille == 0)
+        {
+          fil++;
+        }
+      }
+
+      int cout = atomic_load(&etalement->couts[indice]);
+      if (cout / etalement->largeur_seau != seau || atomic_exchange(&etalement->traites[indice], cout) == cout)
+      {
+        continue;
+      }
+      if (!empiler_case(&ouvrier->reglees, indice))
+      {
+        atomic_store(&etalement->echec, true);
+      }
+      relacher_voisins(ouvrier, indice, cout, true);
+    }
+  }
+}
+
+void relacher_lourds(t_ouvrier *ouvrier)
+{
+  t_etalement *etalement = ouvrier->etalement;
+  if (etalement->largeur_seau >= COUT_DEPLACEMENT_MAX)
+  {
+    return;
+  }
+  for (int i = 0; i < ouvrier->reglees.taille; i++)
+  {
+    int indice = ouvrier->reglees.indices[i];
+    relacher_voisins(ouvrier, indice, atomic_load(&etalement->couts[indice]), false);
+  }
+}
+
+void relacher_voisins(t_ouvrier *ouvrier, int indice, int cout, bool legers)
+{
+  t_etalement *etalement = ouvrier->etalement;
+  const t_terrain *terrain = etalement->terrain;
+
+  for (int i = 0; i < 4; i++)
+  {
+    int voisin = TERRAIN_VOISINE(terrain, indice, i);
+    if (terrain->cases[voisin] == TERRAIN_BORDURE)
+    {
+      continue;
+    }
+
+    int cout_deplacement = 1 + (STATION_MAX_CARBURANT - terrain->cases[voisin]);
+    if ((cout_deplacement <= etalement->largeur_seau) != legers)
+    {
+      continue;
+    }
+
+    // Seul le fil qui abaisse le cout range la case : une case peut ainsi figurer chez plusieurs fils
+    int nouveau_cout = cout + cout_deplacement;
+    if (proposer_minimum(&etalement->couts[voisin], nouveau_cout) &&
+        !empiler_case(&ouvrier->seaux[nouveau_cout / etalement->largeur_seau % etalement->nb_seaux], voisin))
+    {
+      atomic_store(&etalement->echec, true);
+    }
+  }
+}
+
+bool empiler_case(t_seau *seau, int indice)
+{
+  if (seau->taille == seau->capacite)
+  {
+    int capacite = seau->capacite == 0 ? 16 : 2 * seau->capacite;
+    int *indices = realloc(seau->indices, (size_t)capacite * sizeof(int));
+    if (indices == NULL)
+    {
+      return false;
+    }
+    seau->indices = indices;
+    seau->capacite = capacite;
+  }
+  seau->indices[seau->taille++] = indice;
+  return true;
+}
+
+void liberer_ouvrier(t_ouvrier *ouvrier, int nb_seaux)
+{
+  for (int i = 0; ouvrier->seaux != NULL && i < nb_seaux; i++)
+  {
+    free(ouvrier->seaux[i].indices);
+  }
+  free(ouvrier->seaux);
+  free(ouvrier->en_cours.indices);
+  free(ouvrier->reglees.indices);
+}
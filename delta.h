@@ -0,0 +1,33 @@
+#ifndef CODE_DELTA_H
+#define CODE_DELTA_H
+
+#include <stdbool.h> // Pour le type bool
+#include "terrain.h" // Pour le type t_terrain
+
+// ************************************
+// Declarations des fonctions publiques
+// ************************************
+
+/**
+ * @brief Calcule en parallele le cout du plus court chemin d'une case vers toutes les cases du
+ * terrain, par l'algorithme delta-stepping.
+ * Les cases sont rangees dans des seaux de largeur largeur_seau selon leur cout. Les seaux sont
+ * traites dans l'ordre ; a l'interieur d'un seau, les fils se partagent par lots les cases du seau,
+ * quel que soit le fil qui les y a rangees, et relachent leurs deplacements legers (cout au plus
+ * largeur_seau) jusqu'a ce que le seau se vide, puis une seule fois les deplacements lourds des
+ * cases reglees. Un cout n'est abaisse que par echange atomique.
+ * Une largeur de 1 revient a l'algorithme de Dijkstra a seaux ; une largeur d'au moins
+ * 1 + STATION_MAX_CARBURANT rend tous les deplacements legers.
+ * @name delta_calculer_couts
+ * @param terrain le terrain, partage en lecture seule par les fils
+ * @param source_ligne la ligne de la case de depart
+ * @param source_colonne la colonne de la case de depart
+ * @param largeur_seau la largeur des seaux (au moins 1)
+ * @param nb_fils le nombre de fils d'execution (au moins 1)
+ * @param couts le tableau de terrain->nb_cases entiers ou deposer le cout de chaque case, indice comme
+ * les cases du terrain (voir terrain_indice), INT_MAX pour une case inaccessible
+ * @return true si le calcul a abouti, false si les parametres sont invalides ou si la memoire manque
+ */
+bool delta_calculer_couts(const t_terrain *terrain, int source_ligne, int source_colonne, int largeur_seau, int nb_fils, int couts[]);
+
+#endif // CODE_DELTA_H
@@ -1,101 +1,329 @@
 
 
 #include "dijkstra.h"
+#include "seaux.h" // Pour la file de priorite a seaux
+#include "tas.h"   // Pour la file de priorite en tas
+#include "util.h"  // Pour utiliser ABS
 #include <limits.h>
 #include <stdbool.h>
+#include <stdint.h>
 #include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
 
 // ****************************
 // Definitions des types prives
 // ****************************
-// Type pour le tableau des couts qui donne le cout en carburant du plus court chemin du depart a l'une des cases du terrain
-typedef int t_couts[NB_LIGNES][NB_COLONNES];
+// Type pour l'etat d'une recherche de plus court chemin, alloue d'un seul bloc aux dimensions du terrain.
+// Chaque tableau est indice comme les cases du terrain (voir terrain_indice). Les precedents et les
+// cases visitees sont compactes (2 bits et 1 bit par case) pour que l'etat tienne mieux en cache.
+// Le cout et le bit de visite d'une case ne valent que si la case porte le numero de la recherche en
+// cours : changer de numero remet ainsi tout l'etat a zero sans le parcourir.
+typedef struct
+{
+  const t_terrain *terrain;          // Le terrain sur lequel porte la recherche en cours
+  int nb_cases;                      // La taille du tableau des cases des terrains acceptes
+  int pas;                           // Le pas des terrains acceptes
+  t_terrain_disposition disposition; // La disposition des terrains acceptes
+  int *couts;                        // Le cout en carburant du plus court chemin du depart a chaque case
+  uint8_t *precedents;               // La direction d'ou on vient pour atteindre chaque case, 4 cases par octet
+  uint64_t *visitees;                // Indique si une case a deja ete visitee lors de l'algorithme de Dijkstra, 1 bit par case
+  uint32_t *generations;             // Le numero de la derniere recherche qui a touche chaque case
+  uint32_t generation;               // Le numero de la recherche en cours
+} t_recherche;
+
+// Nombre de bits d'un mot du tableau des cases visitees
+#define BITS_PAR_MOT 64
+
+// Type pour la file des cases atteintes mais pas encore visitees, implementee selon le moteur choisi
+typedef struct
+{
+  t_dijkstra_moteur moteur; // La file de priorite effectivement utilisee
+  t_tas tas;                // Utilise avec DIJKSTRA_MOTEUR_TAS et DIJKSTRA_MOTEUR_ASTAR
+  t_seaux seaux;            // Utilise avec DIJKSTRA_MOTEUR_SEAUX
+  int destination_ligne;    // La ligne visee par l'heuristique de DIJKSTRA_MOTEUR_ASTAR
+  int destination_colonne;  // La colonne visee par l'heuristique de DIJKSTRA_MOTEUR_ASTAR
+  const t_terrain *terrain; // Le terrain de la recherche en cours, pour retrouver la position d'un indice
+} t_frontiere;
+
+// Contexte de recherche conserve d'un appel a l'autre pour ne payer que les cases touchees
+struct s_dijkstra_contexte
+{
+  t_dijkstra_moteur moteur;      // Le moteur des recherches faites avec ce contexte
+  t_recherche recherche;         // L'etat par case
+  t_frontiere frontiere;         // La file de priorite, videe mais pas liberee entre deux recherches
+  bool frontiere_allouee;        // Indique si la frontiere a deja ete allouee
+  t_recherche recherche_inverse; // L'etat par case de la recherche depuis la destination (DIJKSTRA_MOTEUR_BIDIRECTIONNEL)
+  t_frontiere frontiere_inverse; // La file de priorite de la recherche depuis la destination
+  bool inverse_alloue;           // Indique si la recherche depuis la destination a deja ete allouee
+};
 
-// Type pour le tableau 2D permettant de savoir si une case a deja ete visitee lors de l'algorithme de Dijkstra
-typedef bool t_visites[NB_LIGNES][NB_COLONNES];
+// Type pour la meilleure jonction connue entre les deux recherches de DIJKSTRA_MOTEUR_BIDIRECTIONNEL
+typedef struct
+{
+  t_recherche *autre; // La recherche de l'autre sens, ou chercher le cout restant d'une case
+  int cout;           // Le cout du meilleur chemin complet connu, INT_MAX s'il n'y en a pas encore
+  int indice;         // La case ou ce chemin passe d'une recherche a l'autre
+} t_jonction;
+
+// Cout maximal d'un deplacement vers une case voisine (case sans carburant)
+#define COUT_DEPLACEMENT_MAX (1 + STATION_MAX_CARBURANT)
+
+// *********************************
+// Definitions des variables privees
+// *********************************
+// Le moteur des contextes crees ensuite, y compris les contextes temporaires des appels sans contexte
+static t_dijkstra_moteur moteur_defaut = DIJKSTRA_MOTEUR_TAS;
 
-// Type pour coder la direction d'ou on vient pour atteindre l'une des cases du terrain en suivant le plus court chemin
-typedef t_direction t_precedents[NB_LIGNES][NB_COLONNES];
+// La direction opposee : t_direction range DROITE, BAS, HAUT, GAUCHE de facon symetrique
+#define DIRECTION_OPPOSEE(direction) ((t_direction)(DIRECTION_GAUCHE - (direction)))
 
 // **********************************
 // Declarations des fonctions privees
 // **********************************
 /**
- * @brief Initialise tous les couts avec le plus grand entier du type int.
- * Initialise egalement le cout de la case du joueur a 0.
+ * @brief Estime le cout restant d'une case jusqu'a la destination par la distance Manhattan.
+ * Chaque deplacement coute au moins 1, l'estimation ne surestime donc jamais le cout reel
+ * et reste coherente d'une case a sa voisine.
+ * @name heuristique_manhattan
+ * @param frontiere la frontiere qui connait la destination
+ * @param indice l'indice lineaire de la case
+ * @return la borne inferieure du cout restant, 0 hors du moteur DIJKSTRA_MOTEUR_ASTAR
+ */
+int heuristique_manhattan(const t_frontiere *frontiere, int indice);
+
+/**
+ * @brief Initialise une frontiere vide avec la file de priorite d'un moteur donne.
+ * @name frontiere_init
+ * @param frontiere la frontiere a initialiser
+ * @param moteur le moteur qui determine la file de priorite a utiliser
+ * @param terrain le terrain sur lequel porteront les recherches
+ * @return true si l'allocation a reussi, false sinon
+ */
+bool frontiere_init(t_frontiere *frontiere, t_dijkstra_moteur moteur, const t_terrain *terrain);
+
+/**
+ * @brief Vide une frontiere pour une nouvelle recherche.
+ * @name frontiere_preparer
+ * @param frontiere la frontiere
+ * @param terrain le terrain de la recherche
+ * @param destination_ligne la ligne de la case a atteindre
+ * @param destination_colonne la colonne de la case a atteindre
+ */
+void frontiere_preparer(t_frontiere *frontiere, const t_terrain *terrain, int destination_ligne, int destination_colonne);
+
+/**
+ * @brief Libere la memoire occupee par une frontiere.
+ * @name frontiere_liberer
+ * @param frontiere la frontiere a liberer
+ */
+void frontiere_liberer(t_frontiere *frontiere);
+
+/**
+ * @brief Indique si la frontiere est vide.
+ * @name frontiere_est_vide
+ * @param frontiere la frontiere a tester
+ * @return true si la frontiere ne contient plus aucune case, false sinon
+ */
+bool frontiere_est_vide(const t_frontiere *frontiere);
+
+/**
+ * @brief Ajoute une case a la frontiere. Avec DIJKSTRA_MOTEUR_ASTAR, la case est classee selon
+ * son cout augmente de l'heuristique.
+ * @name frontiere_inserer
+ * @param frontiere la frontiere
+ * @param priorite le cout de la case
+ * @param indice l'indice lineaire de la case
+ * @return true si la case a ete ajoutee, false si la memoire manque
+ */
+bool frontiere_inserer(t_frontiere *frontiere, int priorite, int indice);
+
+/**
+ * @brief Retire une case de plus petit cout de la frontiere.
+ * @name frontiere_extraire_min
+ * @param frontiere la frontiere, qui ne doit pas etre vide
+ * @param priorite l'adresse ou deposer le cout de la case retiree
+ * @return l'indice lineaire de la case retiree
+ */
+int frontiere_extraire_min(t_frontiere *frontiere, int *priorite);
+
+/**
+ * @brief Alloue les tableaux d'une recherche aux dimensions d'un terrain.
+ * @name recherche_init
+ * @param recherche la recherche a initialiser
+ * @param terrain un terrain aux dimensions des terrains sur lesquels porteront les recherches
+ * @return true si l'allocation a reussi, false sinon
+ */
+bool recherche_init(t_recherche *recherche, const t_terrain *terrain);
+
+/**
+ * @brief Libere les tableaux d'une recherche.
+ * @name recherche_liberer
+ * @param recherche la recherche a liberer
+ */
+void recherche_liberer(t_recherche *recherche);
+
+/**
+ * @brief Commence une nouvelle recherche : tous les couts valent le plus grand entier du type int
+ * et toutes les cases sont non visitees, sauf la case du joueur dont le cout vaut 0.
+ * Se fait en temps constant en changeant le numero de la recherche en cours.
  * @name initialiser_couts
- * @param couts le tableau bi-dimensionnel des couts a initialiser
+ * @param recherche la recherche a initialiser
  * @param joueur_ligne la ligne ou se trouve le joueur
  * @param joueur_colonne la colonne ou se trouve le joueur
  */
-void initialiser_couts(t_couts couts, int joueur_ligne, int joueur_colonne);
+void initialiser_couts(t_recherche *recherche, int joueur_ligne, int joueur_colonne);
+
+/**
+ * @brief Remet a zero le cout et le bit de visite d'une case si elle n'a pas encore ete touchee
+ * par la recherche en cours. Doit preceder toute lecture de l'etat d'une case.
+ * @name toucher_case
+ * @param recherche la recherche
+ * @param indice l'indice de la case
+ */
+void toucher_case(t_recherche *recherche, int indice);
 
 /**
- * @brief Initialise toutes les cases a non visitee.
- * @name initialiser_visitees
- * @param visitees le tableau bi-dimensionnel qui indique, pour chaque case, si elle a deja ete visitee ou non.
+ * @brief Prepare un contexte pour une recherche sur un terrain donne.
+ * @name contexte_preparer
+ * @param contexte le contexte
+ * @param terrain le terrain, aux dimensions du contexte
+ * @param destination_ligne la ligne de la case a atteindre
+ * @param destination_colonne la colonne de la case a atteindre
+ * @return true si le contexte est pret, false si le terrain n'a pas ses dimensions ou si la memoire manque
  */
-void initialiser_visitees(t_visites visitees);
+bool contexte_preparer(t_dijkstra_contexte *contexte, const t_terrain *terrain, int destination_ligne, int destination_colonne);
 
 /**
  * @brief Indique si une case donnee a deja ete visitee au cours de l'algorithme.
  * @name est_case_visitee
- * @param visitees le tableau a 2 dimensions qui indique, pour chaque case, si elle a deja ete visitee durant l'algorithme
- * @param case_ligne la ligne de la case a tester
- * @param case_colonne la colonne de la case a tester
+ * @param recherche la recherche qui indique, pour chaque case, si elle a deja ete visitee durant l'algorithme
+ * @param indice l'indice de la case a tester, deja touchee par la recherche en cours
  * @return true si la case a deja ete visitee, false sinon
  */
-bool est_case_visitee(t_visites visitees, int case_ligne, int case_colonne);
+bool est_case_visitee(const t_recherche *recherche, int indice);
+
+/**
+ * @brief Marque une case comme visitee.
+ * @name marquer_case_visitee
+ * @param recherche la recherche
+ * @param indice l'indice de la case visitee
+ */
+void marquer_case_visitee(t_recherche *recherche, int indice);
+
+/**
+ * @brief Retourne la direction d'ou on vient pour atteindre une case.
+ * @name get_precedent
+ * @param recherche la recherche
+ * @param indice l'indice de la case
+ * @return la direction enregistree pour cette case
+ */
+t_direction get_precedent(const t_recherche *recherche, int indice);
+
+/**
+ * @brief Enregistre la direction d'ou on vient pour atteindre une case.
+ * @name set_precedent
+ * @param recherche la recherche
+ * @param indice l'indice de la case
+ * @param direction la direction a enregistrer (sur 2 bits)
+ */
+void set_precedent(t_recherche *recherche, int indice, t_direction direction);
 
 /**
  * @brief Recherche la case non visitee qui possede le plus petit cout.
+ * Les elements perimes de la file (case deja visitee ou cout depuis ameliore) sont ignores.
+ * Avec le tas, a cout egal, la case choisie est la premiere dans l'ordre de parcours ligne par ligne.
  * @name choisir_min_dist_non_visitee
- * @param couts le tableau des couts
- * @param visitees le tableau qui indique si une case a deja ete visitee ou pas
- * @param case_choisie_ligne l'adresse ou deposer la ligne de la case choisie
- * @param case_choisie_colonne l'adresse ou deposer la colonne de la case choisie
+ * @param frontiere la file de priorite des cases atteintes mais pas encore visitees
+ * @param recherche la recherche qui contient les couts et les cases visitees
+ * @return l'indice lineaire de la case choisie, -1 si aucune
  */
-void choisir_min_dist_non_visitee(t_couts couts, t_visites visitees, int *case_choisie_ligne, int *case_choisie_colonne);
+int choisir_min_dist_non_visitee(t_frontiere *frontiere, const t_recherche *recherche);
 
 /**
  * @brief Retourne le cout de deplacement pour aller d'une case a une case voisine.
  * @name cout_deplacement
  * @param terrain le terrain qui contient les stations de carburant
- * @param voisin_ligne la ligne de la case voisine vers laquelle on veut aller
- * @param voisin_colonne la colonne de la case voisine vers laquelle on veut aller
+ * @param voisin l'indice lineaire de la case voisine vers laquelle on veut aller, hors bordure
  * @return le cout du chemin pour se rendre a la case voisine specifiee en parametre
  * @note le cout pour aller d'une case a l'une de ses voisines est 1 + (9 - carburant dans la case voisine)
  */
-int cout_deplacement(const t_terrain terrain, int voisin_ligne, int voisin_colonne);
+int cout_deplacement(const t_terrain *terrain, int voisin);
 
 /**
  * @brief Parcourt les voisins d'une case donnee et met a jour leur cout dans le tableau des couts.
+ * Les voisins sont atteints par decalage d'indice ; la bordure du terrain ecarte ceux qui en sortent.
+ * Chaque voisin dont le cout s'ameliore est (re)insere dans la file de priorite.
+ * Les precedents sont mis a jour si l'un des chemins ameliore un chemin deja trouve auparavant.
  * @name maj_voisins
- * @param couts le tableau des couts
- * @param visitees le tableau qui indique, pour toute case, si elle a deja ete visitee
- * @param terrain le terrain qui contient les stations de carburant
- * @param precedents le tableau des precedents qui est mis a jour si l'un des chemins ameliore un chemin deja trouve auparavant
- * @param courante_ligne la ligne de la position courante a partir de laquelle on regarde les voisins
- * @param courante_colonne la colonne de la position courante a partir de laquelle on regarde les voisins
+ * @param frontiere la file de priorite des cases atteintes mais pas encore visitees
+ * @param recherche la recherche dont les couts et les precedents sont mis a jour
+ * @param courante l'indice lineaire de la case a partir de laquelle on regarde les voisins
+ * @param inverse true pour une recherche depuis la destination : le cout d'un voisin est alors celui du
+ * chemin du voisin a la destination, et son precedent la direction a prendre pour rejoindre la case courante
+ * @param jonction la meilleure jonction avec la recherche de l'autre sens, a ameliorer (NULL s'il n'y en a pas)
+ * @return true si tous les voisins ameliores ont ete inseres dans la file, false si la memoire manque
+ */
+bool maj_voisins(t_frontiere *frontiere, t_recherche *recherche, int courante, bool inverse, t_jonction *jonction);
+
+/**
+ * @brief Retient une case si le chemin qui y passe d'une recherche a l'autre ameliore la meilleure jonction.
+ * @name noter_jonction
+ * @param jonction la meilleure jonction connue
+ * @param indice l'indice lineaire de la case dont le cout vient de s'ameliorer
+ * @param cout le nouveau cout de la case dans la recherche qui l'a atteinte
  */
-void maj_voisins(t_couts couts, t_visites visitees, const t_terrain terrain, t_precedents precedents, int courante_ligne, int courante_colonne);
+void noter_jonction(t_jonction *jonction, int indice, int cout);
+
+/**
+ * @brief Prolonge les precedents de la recherche depuis le depart de la jonction jusqu'a la destination,
+ * en suivant les directions de la recherche depuis la destination.
+ * @name raccorder_chemins
+ * @param avant la recherche depuis le depart
+ * @param arriere la recherche depuis la destination
+ * @param jonction l'indice lineaire de la case ou les deux recherches se rejoignent
+ * @param destination l'indice lineaire de la destination
+ */
+void raccorder_chemins(t_recherche *avant, const t_recherche *arriere, int jonction, int destination);
 
 /**
  * @brief Affiche le tableau des couts
  * @name afficher_couts
- * @param couts le tableau des couts
- * @param visitees le tableau qui indique si une case a deja ete visitee ou pas durant l'algorithme
+ * @param recherche la recherche qui contient les couts et les cases visitees
  * @param joueur_ligne la ligne ou se trouve le joueur
  * @param joueur_colonne la colonne ou se trouve le joueur
  * @param destination_ligne la ligne de la position a atteindre
  * @param destination_colonne la colonne de la position a atteindre
  */
-void afficher_couts(t_couts couts, t_visites visitees, int joueur_ligne, int joueur_colonne, int destination_ligne, int destination_colonne);
+void afficher_couts(t_recherche *recherche, int joueur_ligne, int joueur_colonne, int destination_ligne, int destination_colonne);
+
+/**
+ * @brief Calcule la case d'ou l'on vient pour atteindre une case sur le plus court chemin.
+ * @name case_precedente
+ * @param recherche la recherche dont les precedents sont a suivre
+ * @param indice l'indice lineaire de la case, atteinte par la recherche
+ * @return l'indice lineaire de la case precedente
+ */
+int case_precedente(const t_recherche *recherche, int indice);
+
+/**
+ * @brief Ecrit le plus court chemin du depart a la destination sous forme de troncons, dans l'ordre
+ * du depart a l'arrivee. Les precedents sont remontes deux fois : une pour compter les troncons,
+ * une pour ranger chacun a sa place.
+ * @name encoder_chemin
+ * @param recherche la recherche, qui doit avoir atteint la destination
+ * @param depart l'indice lineaire de la case de depart
+ * @param destination l'indice lineaire de la case a atteindre
+ * @param troncons le tableau ou deposer les premiers troncons du chemin
+ * @param nb_max le nombre maximal de troncons a deposer
+ * @return le nombre de troncons du chemin complet, qui peut depasser nb_max
+ */
+int encoder_chemin(const t_recherche *recherche, int depart, int destination, t_dijkstra_troncon troncons[], int nb_max);
 
 /**
- * @brief Calcule les 4 premieres cases du plus court chemin en terme de carburant
+ * @brief Calcule les 4 premieres cases du plus court chemin en terme de carburant, a partir du depart
  * @name calculer_chemin_bonus
- * @param precedents tableau de directions qui indique de quelle direction on vient pour atteindre une case du terrain en suivant le plus court chemin
+ * @param recherche la recherche dont les precedents indiquent de quelle direction on vient pour atteindre une case du terrain en suivant le plus court chemin
  * @param depart_ligne la ligne de la case de depart
  * @param depart_colonne la colonne de la case de depart
  * @param destination_ligne la ligne de la case a atteindre
@@ -103,12 +331,40 @@ void afficher_couts(t_couts couts, t_visites visitees, int joueur_ligne, int jou
  * @param directions les 4 premieres directions (au plus) a suivre sur le plus court chemin du depart a l'arrivee
  * @return le nombre de directions proposees par l'algorithme (normalement 4, mais peut etre plus petit)
  */
-int calculer_chemin_bonus(t_precedents precedents, int depart_ligne, int depart_colonne, int destination_ligne, int destination_colonne, t_direction directions[NB_CASES_BONUS]);
+int calculer_chemin_bonus(const t_recherche *recherche, int depart_ligne, int depart_colonne, int destination_ligne, int destination_colonne, t_direction directions[NB_CASES_BONUS]);
+
+/**
+ * @brief Developpe les cases depuis la position du joueur, avec le moteur du contexte, jusqu'a
+ * atteindre la destination ou epuiser les cases accessibles.
+ * @name explorer
+ * @param contexte le contexte, prepare pour le terrain, dont les couts et les precedents sont a remplir
+ * @param joueur_ligne la ligne ou se trouve le joueur
+ * @param joueur_colonne la colonne ou se trouve le joueur
+ * @param destination_ligne la ligne de la case a atteindre
+ * @param destination_colonne la colonne de la case a atteindre
+ * @return le nombre de cases developpees, -1 si la memoire manque
+ */
+int explorer(t_dijkstra_contexte *contexte, int joueur_ligne, int joueur_colonne, int destination_ligne, int destination_colonne);
+
+/**
+ * @brief Developpe alternativement les cases depuis le joueur et depuis la destination, jusqu'a ce que
+ * les couts des deux frontieres ne puissent plus ameliorer le meilleur chemin qui les relie. Le chemin
+ * trouve est ensuite recopie dans les couts et les precedents de la recherche depuis le joueur.
+ * @name explorer_bidirectionnel
+ * @param contexte le contexte, prepare pour le terrain, dont les couts et les precedents sont a remplir
+ * @param joueur_ligne la ligne ou se trouve le joueur
+ * @param joueur_colonne la colonne ou se trouve le joueur
+ * @param destination_ligne la ligne de la case a atteindre
+ * @param destination_colonne la colonne de la case a atteindre
+ * @return le nombre de cases developpees par les deux recherches, -1 si la memoire manque
+ */
+int explorer_bidirectionnel(t_dijkstra_contexte *contexte, int joueur_ligne, int joueur_colonne, int destination_ligne, int destination_colonne);
 
 /**
  * @brief Algorithme de Dijkstra pour calculer le plus court chemin en partent de la position du joueur pour atteindre
  * la position de destination.
  * @name dijkstra
+ * @param contexte le contexte de recherche a reutiliser, NULL pour en allouer un le temps de l'appel
  * @param terrain la terrain sur lequel le joueur evolue
  * @param joueur_ligne la ligne ou se trouve le joueur
  * @param joueur_colonne la colonne ou se trouve le joueur
@@ -117,20 +373,119 @@ int calculer_chemin_bonus(t_precedents precedents, int depart_ligne, int depart_
  * @param directions les 4 premieres directions a suivre sur le plus court chemin
  * @return le nombre de directions proposees par l'algorithme (normalement 4, mais peut etre plus petit)
  */
-int dijkstra(const t_terrain terrain, int joueur_ligne, int joueur_colonne, int destination_ligne, int destination_colonne, t_direction directions[NB_CASES_BONUS]);
-
-/**
- * @brief Affiche les 4 premieres directions a suivre sur le plus court chemin pour joindre la destination a partir de la position du joueur
- * @name afficher_direction_suggeree
- * @param directions les premieres directions a suivre sur le plus court chemin
- * @param nb le nombre de directions a suivre
- */
-void afficher_direction_suggeree(t_direction directions[NB_CASES_BONUS], int nb);
+int dijkstra(t_dijkstra_contexte *contexte, const t_terrain *terrain, int joueur_ligne, int joueur_colonne, int destination_ligne, int destination_colonne, t_direction directions[NB_CASES_BONUS]);
 
 // ***********************************
 // Definitions des fonctions publiques
 // ***********************************
-void dijkstra_acheter_bonus(const t_terrain terrain, int joueur_ligne, int joueur_colonne, int *joueur_carburant, int destination_ligne, int destination_colonne)
+void dijkstra_choisir_moteur(t_dijkstra_moteur moteur)
+{
+  moteur_defaut = moteur;
+}
+
+void dijkstra_contexte_choisir_moteur(t_dijkstra_contexte *contexte, t_dijkstra_moteur moteur)
+{
+  contexte->moteur = moteur;
+}
+
+t_dijkstra_contexte *dijkstra_contexte_creer(const t_terrain *terrain)
+{
+  t_dijkstra_contexte *contexte = malloc(sizeof(t_dijkstra_contexte));
+  if (contexte == NULL)
+  {
+    return NULL;
+  }
+  if (!recherche_init(&contexte->recherche, terrain))
+  {
+    free(contexte);
+    return NULL;
+  }
+  contexte->moteur = moteur_defaut;
+  contexte->frontiere_allouee = false;
+  contexte->inverse_alloue = false;
+  return contexte;
+}
+
+void dijkstra_contexte_detruire(t_dijkstra_contexte *contexte)
+{
+  if (contexte != NULL)
+  {
+    if (contexte->frontiere_allouee)
+    {
+      frontiere_liberer(&contexte->frontiere);
+    }
+    if (contexte->inverse_alloue)
+    {
+      frontiere_liberer(&contexte->frontiere_inverse);
+      recherche_liberer(&contexte->recherche_inverse);
+    }
+    recherche_liberer(&contexte->recherche);
+    free(contexte);
+  }
+}
+
+int dijkstra_calculer_cout(t_dijkstra_contexte *contexte, const t_terrain *terrain, int depart_ligne, int depart_colonne, int destination_ligne, int destination_colonne, int *nb_expansions)
+{
+  t_dijkstra_contexte *temporaire = NULL;
+  int cout = -1;
+  int nb = -1;
+
+  if (contexte == NULL)
+  {
+    contexte = temporaire = dijkstra_contexte_creer(terrain);
+  }
+
+  if (contexte != NULL && contexte_preparer(contexte, terrain, destination_ligne, destination_colonne))
+  {
+    nb = explorer(contexte, depart_ligne, depart_colonne, destination_ligne, destination_colonne);
+    int destination = terrain_indice(terrain, destination_ligne, destination_colonne);
+    toucher_case(&contexte->recherche, destination);
+    if (nb >= 0 && contexte->recherche.couts[destination] != INT_MAX)
+    {
+      cout = contexte->recherche.couts[destination];
+    }
+  }
+  dijkstra_contexte_detruire(temporaire);
+
+  if (nb_expansions != NULL)
+  {
+    *nb_expansions = nb;
+  }
+  return cout;
+}
+
+int dijkstra_calculer_chemin(t_dijkstra_contexte *contexte, const t_terrain *terrain, int depart_ligne, int depart_colonne, int destination_ligne, int destination_colonne, t_dijkstra_troncon troncons[], int nb_max, int *cout)
+{
+  t_dijkstra_contexte *temporaire = NULL;
+  int cout_total = -1;
+  int nb_troncons = -1;
+
+  if (contexte == NULL)
+  {
+    contexte = temporaire = dijkstra_contexte_creer(terrain);
+  }
+
+  if (contexte != NULL && contexte_preparer(contexte, terrain, destination_ligne, destination_colonne) &&
+      explorer(contexte, depart_ligne, depart_colonne, destination_ligne, destination_colonne) >= 0)
+  {
+    int destination = terrain_indice(terrain, destination_ligne, destination_colonne);
+    toucher_case(&contexte->recherche, destination);
+    if (contexte->recherche.couts[destination] != INT_MAX)
+    {
+      cout_total = contexte->recherche.couts[destination];
+      nb_troncons = encoder_chemin(&contexte->recherche, terrain_indice(terrain, depart_ligne, depart_colonne), destination, troncons, nb_max);
+    }
+  }
+  dijkstra_contexte_detruire(temporaire);
+
+  if (cout != NULL)
+  {
+    *cout = cout_total;
+  }
+  return nb_troncons;
+}
+
+void dijkstra_acheter_bonus(t_dijkstra_contexte *contexte, const t_terrain *terrain, int joueur_ligne, int joueur_colonne, int *joueur_carburant, int destination_ligne, int destination_colonne)
 {
   if (*joueur_carburant < 10)
   {
@@ -139,12 +494,12 @@ void dijkstra_acheter_bonus(const t_terrain terrain, int joueur_ligne, int joueu
   }
 
   t_direction directions[NB_CASES_BONUS];
-  int nb_directions = dijkstra(terrain, joueur_ligne, joueur_colonne, destination_ligne, destination_colonne, directions);
+  int nb_directions = dijkstra(contexte, terrain, joueur_ligne, joueur_colonne, destination_ligne, destination_colonne, directions);
 
   if (nb_directions > 0)
   {
     *joueur_carburant -= 10;
-    afficher_direction_suggeree(directions, nb_directions);
+    dijkstra_afficher_directions_suggerees(directions, nb_directions);
   }
   else
   {
@@ -152,94 +507,314 @@ void dijkstra_acheter_bonus(const t_terrain terrain, int joueur_ligne, int joueu
   }
 }
 
+void dijkstra_afficher_directions_suggerees(const t_direction directions[], int nb)
+{
+  printf("Directions suggerees : ");
+  for (int i = 0; i < nb; i++)
+  {
+    switch (directions[i])
+    {
+    case DIRECTION_HAUT:
+      printf("Haut ");
+      break;
+    case DIRECTION_BAS:
+      printf("Bas ");
+      break;
+    case DIRECTION_GAUCHE:
+      printf("Gauche ");
+      break;
+    case DIRECTION_DROITE:
+      printf("Droite ");
+      break;
+    }
+  }
+  printf("\n");
+}
+
 // *********************************
 // Definitions des fonctions privees
 // *********************************
-void initialiser_couts(t_couts couts, int joueur_ligne, int joueur_colonne)
+int heuristique_manhattan(const t_frontiere *frontiere, int indice)
 {
-  for (int i = 0; i < NB_LIGNES; i++)
+  if (frontiere->moteur != DIJKSTRA_MOTEUR_ASTAR)
   {
-    for (int j = 0; j < NB_COLONNES; j++)
-    {
-      couts[i][j] = INT_MAX;
-    }
+    return 0;
   }
-  couts[joueur_ligne][joueur_colonne] = 0;
+  int ligne = terrain_ligne(frontiere->terrain, indice);
+  int colonne = terrain_colonne(frontiere->terrain, indice);
+  return ABS(frontiere->destination_ligne - ligne) + ABS(frontiere->destination_colonne - colonne);
 }
 
-void initialiser_visitees(t_visites visitees)
+bool frontiere_init(t_frontiere *frontiere, t_dijkstra_moteur moteur, const t_terrain *terrain)
 {
-  for (int i = 0; i < NB_LIGNES; i++)
+  frontiere->moteur = moteur;
+  frontiere->destination_ligne = 0;
+  frontiere->destination_colonne = 0;
+  frontiere->terrain = terrain;
+  if (moteur == DIJKSTRA_MOTEUR_SEAUX)
   {
-    for (int j = 0; j < NB_COLONNES; j++)
-    {
-      visitees[i][j] = false;
-    }
+    return seaux_init(&frontiere->seaux, COUT_DEPLACEMENT_MAX);
   }
+  return tas_init(&frontiere->tas, terrain->nb_lignes + terrain->nb_colonnes);
 }
 
-bool est_case_visitee(t_visites visitees, int case_ligne, int case_colonne)
+void frontiere_liberer(t_frontiere *frontiere)
 {
-  return visitees[case_ligne][case_colonne];
+  if (frontiere->moteur == DIJKSTRA_MOTEUR_SEAUX)
+  {
+    seaux_liberer(&frontiere->seaux);
+  }
+  else
+  {
+    tas_liberer(&frontiere->tas);
+  }
 }
 
-void choisir_min_dist_non_visitee(t_couts couts, t_visites visitees, int *case_choisie_ligne, int *case_choisie_colonne)
+void frontiere_preparer(t_frontiere *frontiere, const t_terrain *terrain, int destination_ligne, int destination_colonne)
 {
-  int min_cout = INT_MAX;
-  *case_choisie_ligne = -1;
-  *case_choisie_colonne = -1;
+  frontiere->terrain = terrain;
+  frontiere->destination_ligne = destination_ligne;
+  frontiere->destination_colonne = destination_colonne;
+  if (frontiere->moteur == DIJKSTRA_MOTEUR_SEAUX)
+  {
+    seaux_vider(&frontiere->seaux);
+  }
+  else
+  {
+    tas_vider(&frontiere->tas);
+  }
+}
+
+bool frontiere_est_vide(const t_frontiere *frontiere)
+{
+  if (frontiere->moteur == DIJKSTRA_MOTEUR_SEAUX)
+  {
+    return seaux_est_vide(&frontiere->seaux);
+  }
+  return tas_est_vide(&frontiere->tas);
+}
+
+bool frontiere_inserer(t_frontiere *frontiere, int priorite, int indice)
+{
+  priorite += heuristique_manhattan(frontiere, indice);
+  if (frontiere->moteur == DIJKSTRA_MOTEUR_SEAUX)
+  {
+    return seaux_inserer(&frontiere->seaux, priorite, indice);
+  }
+  return tas_inserer(&frontiere->tas, priorite, indice);
+}
+
+int frontiere_extraire_min(t_frontiere *frontiere, int *priorite)
+{
+  if (frontiere->moteur == DIJKSTRA_MOTEUR_SEAUX)
+  {
+    return seaux_extraire_min(&frontiere->seaux, priorite);
+  }
+  t_tas_element element = tas_extraire_min(&frontiere->tas);
+  *priorite = element.priorite - heuristique_manhattan(frontiere, element.indice);
+  return element.indice;
+}
+
+bool recherche_init(t_recherche *recherche, const t_terrain *terrain)
+{
+  size_t nb_cases = (size_t)terrain->nb_cases;
+  size_t nb_mots = (nb_cases + BITS_PAR_MOT - 1) / BITS_PAR_MOT;
+
+  // Un seul bloc, du type le plus aligne au moins aligne : cases visitees, couts, generations, precedents
+  uint64_t *bloc = malloc(nb_mots * sizeof(uint64_t) + nb_cases * (sizeof(int) + sizeof(uint32_t)) + (nb_cases + 3) / 4);
+  recherche->terrain = terrain;
+  recherche->nb_cases = terrain->nb_cases;
+  recherche->pas = terrain->pas;
+  recherche->disposition = terrain->disposition;
+  recherche->visitees = bloc;
+  recherche->couts = (int *)(bloc + nb_mots);
+  recherche->generations = (uint32_t *)(recherche->couts + nb_cases);
+  recherche->precedents = (uint8_t *)(recherche->generations + nb_cases);
+  recherche->generation = 0;
+  if (bloc == NULL)
+  {
+    return false;
+  }
+
+  // Aucune case n'a encore ete touchee : la premiere recherche aura le numero 1
+  memset(recherche->generations, 0, nb_cases * sizeof(uint32_t));
+  return true;
+}
 
-  for (int i = 0; i < NB_LIGNES; i++)
+void recherche_liberer(t_recherche *recherche)
+{
+  free(recherche->visitees);
+  recherche->couts = NULL;
+  recherche->visitees = NULL;
+  recherche->generations = NULL;
+  recherche->precedents = NULL;
+}
+
+void initialiser_couts(t_recherche *recherche, int joueur_ligne, int joueur_colonne)
+{
+  recherche->generation++;
+  if (recherche->generation == 0)
+  {
+    // Apres 2^32 recherches, les numeros rebouclent : on efface une fois pour toutes les anciens numeros
+    memset(recherche->generations, 0, (size_t)recherche->nb_cases * sizeof(uint32_t));
+    recherche->generation = 1;
+  }
+
+  int joueur = terrain_indice(recherche->terrain, joueur_ligne, joueur_colonne);
+  toucher_case(recherche, joueur);
+  recherche->couts[joueur] = 0;
+}
+
+void toucher_case(t_recherche *recherche, int indice)
+{
+  if (recherche->generations[indice] != recherche->generation)
+  {
+    recherche->generations[indice] = recherche->generation;
+    recherche->couts[indice] = INT_MAX;
+    recherche->visitees[indice / BITS_PAR_MOT] &= ~((uint64_t)1 << (indice % BITS_PAR_MOT));
+  }
+}
+
+bool contexte_preparer(t_dijkstra_contexte *contexte, const t_terrain *terrain, int destination_ligne, int destination_colonne)
+{
+  if (terrain->nb_cases != contexte->recherche.nb_cases || terrain->pas != contexte->recherche.pas ||
+      terrain->disposition != contexte->recherche.disposition)
   {
-    for (int j = 0; j < NB_COLONNES; j++)
+    printf("Le contexte de recherche ne correspond pas aux dimensions du terrain.\n");
+    return false;
+  }
+  contexte->recherche.terrain = terrain;
+
+  // La file de priorite n'est reallouee que si le moteur a change depuis la derniere recherche
+  if (contexte->frontiere_allouee && contexte->frontiere.moteur != contexte->moteur)
+  {
+    frontiere_liberer(&contexte->frontiere);
+    contexte->frontiere_allouee = false;
+  }
+  if (!contexte->frontiere_allouee)
+  {
+    if (!frontiere_init(&contexte->frontiere, contexte->moteur, terrain))
+    {
+      printf("Memoire insuffisante pour calculer le chemin.\n");
+      return false;
+    }
+    contexte->frontiere_allouee = true;
+  }
+
+  frontiere_preparer(&contexte->frontiere, terrain, destination_ligne, destination_colonne);
+
+  // La recherche depuis la destination n'est allouee qu'a la premiere utilisation du moteur bidirectionnel
+  if (contexte->moteur == DIJKSTRA_MOTEUR_BIDIRECTIONNEL)
+  {
+    if (!contexte->inverse_alloue)
     {
-      if (!visitees[i][j] && couts[i][j] < min_cout)
+      if (!recherche_init(&contexte->recherche_inverse, terrain))
       {
-        min_cout = couts[i][j];
-        *case_choisie_ligne = i;
-        *case_choisie_colonne = j;
+        printf("Memoire insuffisante pour calculer le chemin.\n");
+        return false;
       }
+      if (!frontiere_init(&contexte->frontiere_inverse, DIJKSTRA_MOTEUR_BIDIRECTIONNEL, terrain))
+      {
+        recherche_liberer(&contexte->recherche_inverse);
+        printf("Memoire insuffisante pour calculer le chemin.\n");
+        return false;
+      }
+      contexte->inverse_alloue = true;
     }
+    contexte->recherche_inverse.terrain = terrain;
+    frontiere_preparer(&contexte->frontiere_inverse, terrain, destination_ligne, destination_colonne);
   }
+  return true;
+}
+
+bool est_case_visitee(const t_recherche *recherche, int indice)
+{
+  return (recherche->visitees[indice / BITS_PAR_MOT] >> (indice % BITS_PAR_MOT)) & 1;
 }
 
-int cout_deplacement(const t_terrain terrain, int voisin_ligne, int voisin_colonne)
+void marquer_case_visitee(t_recherche *recherche, int indice)
 {
-  return 1 + (9 - terrain[voisin_ligne][voisin_colonne]);
+  recherche->visitees[indice / BITS_PAR_MOT] |= (uint64_t)1 << (indice % BITS_PAR_MOT);
 }
 
-void maj_voisins(t_couts couts, t_visites visitees, const t_terrain terrain, t_precedents precedents, int courante_ligne, int courante_colonne)
+t_direction get_precedent(const t_recherche *recherche, int indice)
 {
-  int directions[4][2] = {{-1, 0}, {1, 0}, {0, -1}, {0, 1}}; // Haut, Bas, Gauche, Droite
+  return (t_direction)((recherche->precedents[indice / 4] >> (2 * (indice % 4))) & 3);
+}
 
-  for (int i = 0; i < 4; i++)
+void set_precedent(t_recherche *recherche, int indice, t_direction direction)
+{
+  uint8_t *octet = &recherche->precedents[indice / 4];
+  int decalage = 2 * (indice % 4);
+  *octet = (uint8_t)((*octet & ~(3 << decalage)) | ((direction & 3) << decalage));
+}
+
+int choisir_min_dist_non_visitee(t_frontiere *frontiere, const t_recherche *recherche)
+{
+  while (!frontiere_est_vide(frontiere))
   {
-    int voisin_ligne = courante_ligne + directions[i][0];
-    int voisin_colonne = courante_colonne + directions[i][1];
+    int priorite;
+    int indice = frontiere_extraire_min(frontiere, &priorite);
 
-    if (voisin_ligne >= 0 && voisin_ligne < NB_LIGNES && voisin_colonne >= 0 && voisin_colonne < NB_COLONNES)
+    // Ignorer les elements perimes
+    if (!est_case_visitee(recherche, indice) && priorite == recherche->couts[indice])
     {
-      if (!est_case_visitee(visitees, voisin_ligne, voisin_colonne))
+      return indice;
+    }
+  }
+  return -1;
+}
+
+int cout_deplacement(const t_terrain *terrain, int voisin)
+{
+  return 1 + (9 - terrain->cases[voisin]);
+}
+
+bool maj_voisins(t_frontiere *frontiere, t_recherche *recherche, int courante, bool inverse, t_jonction *jonction)
+{
+  const t_terrain *terrain = recherche->terrain;
+
+  for (t_direction direction = DIRECTION_DROITE; direction <= DIRECTION_GAUCHE; direction++)
+  {
+    int voisin = TERRAIN_VOISINE(terrain, courante, direction);
+
+    if (terrain->cases[voisin] != TERRAIN_BORDURE)
+    {
+      toucher_case(recherche, voisin);
+      if (!est_case_visitee(recherche, voisin))
       {
-        int nouveau_cout = couts[courante_ligne][courante_colonne] + cout_deplacement(terrain, voisin_ligne, voisin_colonne);
+        // A rebours, on paie l'entree dans la case courante depuis le voisin
+        int nouveau_cout = recherche->couts[courante] + cout_deplacement(terrain, inverse ? courante : voisin);
 
-        if (nouveau_cout < couts[voisin_ligne][voisin_colonne])
+        if (nouveau_cout < recherche->couts[voisin])
         {
-          couts[voisin_ligne][voisin_colonne] = nouveau_cout;
-          precedents[voisin_ligne][voisin_colonne] = i;
+          recherche->couts[voisin] = nouveau_cout;
+          set_precedent(recherche, voisin, inverse ? DIRECTION_OPPOSEE(direction) : direction);
+          if (!frontiere_inserer(frontiere, nouveau_cout, voisin))
+          {
+            return false; // Une case perdue fausserait le chemin : la recherche echoue
+          }
+          if (jonction != NULL)
+          {
+            noter_jonction(jonction, voisin, nouveau_cout);
+          }
         }
       }
     }
   }
+  return true;
 }
 
-void afficher_couts(t_couts couts, t_visites visitees, int joueur_ligne, int joueur_colonne, int destination_ligne, int destination_colonne)
+void afficher_couts(t_recherche *recherche, int joueur_ligne, int joueur_colonne, int destination_ligne, int destination_colonne)
 {
+  const t_terrain *terrain = recherche->terrain;
   printf("Tableau des couts :\n");
-  for (int i = 0; i < NB_LIGNES; i++)
+  for (int i = 0; i < terrain->nb_lignes; i++)
   {
-    for (int j = 0; j < NB_COLONNES; j++)
+    for (int j = 0; j < terrain->nb_colonnes; j++)
     {
+      int indice = terrain_indice(terrain, i, j);
+      toucher_case(recherche, indice);
       if (i == joueur_ligne && j == joueur_colonne)
       {
         printf("J ");
@@ -248,9 +823,9 @@ void afficher_couts(t_couts couts, t_visites visitees, int joueur_ligne, int jou
       {
         printf("D ");
       }
-      else if (visitees[i][j])
+      else if (est_case_visitee(recherche, indice))
       {
-        printf("%d ", couts[i][j]);
+        printf("%d ", recherche->couts[indice]);
       }
       else
       {
@@ -261,98 +836,225 @@ void afficher_couts(t_couts couts, t_visites visitees, int joueur_ligne, int jou
   }
 }
 
-int calculer_chemin_bonus(t_precedents precedents, int depart_ligne, int depart_colonne, int destination_ligne, int destination_colonne, t_direction directions[NB_CASES_BONUS])
+int case_precedente(const t_recherche *recherche, int indice)
 {
-  int nb_directions = 0;
-  int ligne = destination_ligne;
-  int colonne = destination_colonne;
+  return TERRAIN_VOISINE(recherche->terrain, indice, DIRECTION_OPPOSEE(get_precedent(recherche, indice)));
+}
 
-  while ((ligne != depart_ligne || colonne != depart_colonne) && nb_directions < NB_CASES_BONUS)
+int encoder_chemin(const t_recherche *recherche, int depart, int destination, t_dijkstra_troncon troncons[], int nb_max)
+{
+  // Premier passage : compter les troncons en remontant de la destination au depart
+  int nb_troncons = 0;
+  t_direction precedente = DIRECTION_ERRONEE;
+  for (int indice = destination; indice != depart; indice = case_precedente(recherche, indice))
   {
-    t_direction dir = precedents[ligne][colonne];
-    directions[nb_directions] = dir;
-    nb_directions++;
-
-    // Mettre à jour la position actuelle en fonction de la direction
-    switch (dir)
+    t_direction direction = get_precedent(recherche, indice);
+    if (direction != precedente)
     {
-    case DIRECTION_HAUT:
-      ligne++;
-      break;
-    case DIRECTION_BAS:
-      ligne--;
-      break;
-    case DIRECTION_GAUCHE:
-      colonne++;
-      break;
-    case DIRECTION_DROITE:
-      colonne--;
-      break;
+      nb_troncons++;
+      precedente = direction;
     }
   }
 
-  // Inverser les directions pour les avoir dans l'ordre du départ à l'arrivée
-  for (int i = 0; i < nb_directions / 2; i++)
+  // Second passage : remplir les troncons du dernier au premier, en ne gardant que les nb_max premiers
+  int k = nb_troncons;
+  precedente = DIRECTION_ERRONEE;
+  for (int indice = destination; indice != depart; indice = case_precedente(recherche, indice))
   {
-    t_direction temp = directions[i];
-    directions[i] = directions[nb_directions - 1 - i];
-    directions[nb_directions - 1 - i] = temp;
+    t_direction direction = get_precedent(recherche, indice);
+    if (direction != precedente)
+    {
+      k--;
+      precedente = direction;
+      if (k < nb_max)
+      {
+        troncons[k].direction = direction;
+        troncons[k].longueur = 0;
+      }
+    }
+    if (k < nb_max)
+    {
+      troncons[k].longueur++;
+    }
   }
 
+  return nb_troncons;
+}
+
+int calculer_chemin_bonus(const t_recherche *recherche, int depart_ligne, int depart_colonne, int destination_ligne, int destination_colonne, t_direction directions[NB_CASES_BONUS])
+{
+  // NB_CASES_BONUS directions tiennent toujours dans NB_CASES_BONUS troncons
+  t_dijkstra_troncon troncons[NB_CASES_BONUS];
+  int depart = terrain_indice(recherche->terrain, depart_ligne, depart_colonne);
+  int destination = terrain_indice(recherche->terrain, destination_ligne, destination_colonne);
+  int nb_troncons = MIN(encoder_chemin(recherche, depart, destination, troncons, NB_CASES_BONUS), NB_CASES_BONUS);
+
+  int nb_directions = 0;
+  for (int k = 0; k < nb_troncons && nb_directions < NB_CASES_BONUS; k++)
+  {
+    for (int n = 0; n < troncons[k].longueur && nb_directions < NB_CASES_BONUS; n++)
+    {
+      directions[nb_directions] = troncons[k].direction;
+      nb_directions++;
+    }
+  }
   return nb_directions;
 }
 
-int dijkstra(const t_terrain terrain, int joueur_ligne, int joueur_colonne, int destination_ligne, int destination_colonne, t_direction directions[NB_CASES_BONUS])
+int explorer(t_dijkstra_contexte *contexte, int joueur_ligne, int joueur_colonne, int destination_ligne, int destination_colonne)
 {
-  t_couts couts;
-  t_visites visitees;
-  t_precedents precedents;
+  if (contexte->frontiere.moteur == DIJKSTRA_MOTEUR_BIDIRECTIONNEL)
+  {
+    return explorer_bidirectionnel(contexte, joueur_ligne, joueur_colonne, destination_ligne, destination_colonne);
+  }
 
-  initialiser_couts(couts, joueur_ligne, joueur_colonne);
-  initialiser_visitees(visitees);
+  t_recherche *recherche = &contexte->recherche;
+  t_frontiere *frontiere = &contexte->frontiere;
+  const t_terrain *terrain = recherche->terrain;
+  int nb_expansions = 0;
 
+  initialiser_couts(recherche, joueur_ligne, joueur_colonne);
+  if (!frontiere_inserer(frontiere, 0, terrain_indice(terrain, joueur_ligne, joueur_colonne)))
+  {
+    printf("Memoire insuffisante pour calculer le chemin.\n");
+    return -1;
+  }
+
+  int destination = terrain_indice(terrain, destination_ligne, destination_colonne);
   while (true)
   {
-    int case_choisie_ligne, case_choisie_colonne;
-    choisir_min_dist_non_visitee(couts, visitees, &case_choisie_ligne, &case_choisie_colonne);
+    int choisie = choisir_min_dist_non_visitee(frontiere, recherche);
 
-    if (case_choisie_ligne == -1 || case_choisie_colonne == -1)
+    if (choisie == -1)
     {
       break; // Toutes les cases ont été visitées ou aucun chemin n'est possible
     }
 
-    if (case_choisie_ligne == destination_ligne && case_choisie_colonne == destination_colonne)
+    if (choisie == destination)
     {
       break; // Destination atteinte
     }
 
-    visitees[case_choisie_ligne][case_choisie_colonne] = true;
-    maj_voisins(couts, visitees, terrain, precedents, case_choisie_ligne, case_choisie_colonne);
+    marquer_case_visitee(recherche, choisie);
+    if (!maj_voisins(frontiere, recherche, choisie, false, NULL))
+    {
+      printf("Memoire insuffisante pour calculer le chemin.\n");
+      return -1;
+    }
+    nb_expansions++;
   }
 
-  return calculer_chemin_bonus(precedents, joueur_ligne, joueur_colonne, destination_ligne, destination_colonne, directions);
+  return nb_expansions;
 }
 
-void afficher_direction_suggeree(t_direction directions[NB_CASES_BONUS], int nb)
+int explorer_bidirectionnel(t_dijkstra_contexte *contexte, int joueur_ligne, int joueur_colonne, int destination_ligne, int destination_colonne)
 {
-  printf("Directions suggerees : ");
-  for (int i = 0; i < nb; i++)
+  t_recherche *recherches[2] = {&contexte->recherche, &contexte->recherche_inverse};
+  t_frontiere *frontieres[2] = {&contexte->frontiere, &contexte->frontiere_inverse};
+  const t_terrain *terrain = contexte->recherche.terrain;
+  int depart = terrain_indice(terrain, joueur_ligne, joueur_colonne);
+  int destination = terrain_indice(terrain, destination_ligne, destination_colonne);
+  int derniers_couts[2] = {0, 0}; // Le cout de la derniere case sortie de chaque frontiere
+  int nb_expansions = 0;
+
+  initialiser_couts(recherches[0], joueur_ligne, joueur_colonne);
+  initialiser_couts(recherches[1], destination_ligne, destination_colonne);
+  if (!frontiere_inserer(frontieres[0], 0, depart) || !frontiere_inserer(frontieres[1], 0, destination))
   {
-    switch (directions[i])
+    printf("Memoire insuffisante pour calculer le chemin.\n");
+    return -1;
+  }
+  t_jonction jonction = {NULL, INT_MAX, -1};
+  if (depart == destination)
+  {
+    jonction.cout = 0;
+    jonction.indice = depart;
+  }
+
+  int sens = 0;
+  while (true)
+  {
+    int choisie = choisir_min_dist_non_visitee(frontieres[sens], recherches[sens]);
+
+    if (choisie == -1)
+    {
+      break; // Un sens a epuise ses cases : tout chemin a deja ete vu depuis l'autre sens
+    }
+
+    // Tout chemin encore inconnu couterait au moins la somme des couts des deux frontieres
+    derniers_couts[sens] = recherches[sens]->couts[choisie];
+    if (jonction.cout != INT_MAX && derniers_couts[0] + derniers_couts[1] >= jonction.cout)
     {
-    case DIRECTION_HAUT:
-      printf("Haut ");
-      break;
-    case DIRECTION_BAS:
-      printf("Bas ");
-      break;
-    case DIRECTION_GAUCHE:
-      printf("Gauche ");
-      break;
-    case DIRECTION_DROITE:
-      printf("Droite ");
       break;
     }
+
+    marquer_case_visitee(recherches[sens], choisie);
+    jonction.autre = recherches[1 - sens];
+    if (!maj_voisins(frontieres[sens], recherches[sens], choisie, sens == 1, &jonction))
+    {
+      printf("Memoire insuffisante pour calculer le chemin.\n");
+      return -1;
+    }
+    nb_expansions++;
+    sens = 1 - sens;
   }
-  printf("\n");
-}
\ No newline at end of file
+
+  if (jonction.cout != INT_MAX)
+  {
+    raccorder_chemins(recherches[0], recherches[1], jonction.indice, destination);
+  }
+  return nb_expansions;
+}
+
+void noter_jonction(t_jonction *jonction, int indice, int cout)
+{
+  toucher_case(jonction->autre, indice);
+  int cout_autre = jonction->autre->couts[indice];
+  if (cout_autre != INT_MAX && cout + cout_autre < jonction->cout)
+  {
+    jonction->cout = cout + cout_autre;
+    jonction->indice = indice;
+  }
+}
+
+void raccorder_chemins(t_recherche *avant, const t_recherche *arriere, int jonction, int destination)
+{
+  const t_terrain *terrain = avant->terrain;
+  int courante = jonction;
+  while (courante != destination)
+  {
+    t_direction direction = get_precedent(arriere, courante);
+    int suivante = TERRAIN_VOISINE(terrain, courante, direction);
+
+    toucher_case(avant, suivante);
+    avant->couts[suivante] = avant->couts[courante] + cout_deplacement(terrain, suivante);
+    set_precedent(avant, suivante, direction);
+    courante = suivante;
+  }
+}
+
+int dijkstra(t_dijkstra_contexte *contexte, const t_terrain *terrain, int joueur_ligne, int joueur_colonne, int destination_ligne, int destination_colonne, t_direction directions[NB_CASES_BONUS])
+{
+  t_dijkstra_contexte *temporaire = NULL;
+  int nb_directions = 0;
+
+  if (contexte == NULL)
+  {
+    contexte = temporaire = dijkstra_contexte_creer(terrain);
+    if (contexte == NULL)
+    {
+      printf("Memoire insuffisante pour calculer le chemin.\n");
+      return 0;
+    }
+  }
+
+  int destination = terrain_indice(terrain, destination_ligne, destination_colonne);
+  if (contexte_preparer(contexte, terrain, destination_ligne, destination_colonne) &&
+      explorer(contexte, joueur_ligne, joueur_colonne, destination_ligne, destination_colonne) >= 0 &&
+      (toucher_case(&contexte->recherche, destination), contexte->recherche.couts[destination] != INT_MAX))
+  {
+    nb_directions = calculer_chemin_bonus(&contexte->recherche, joueur_ligne, joueur_colonne, destination_ligne, destination_colonne, directions);
+  }
+  dijkstra_contexte_detruire(temporaire);
+  return nb_directions;
+}
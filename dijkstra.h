@@ -8,14 +8,113 @@
 
 #define NB_CASES_BONUS 4
 
+// *****************************
+// Definitions des types publics
+// *****************************
+
+/**
+ * @brief Les files de priorite disponibles pour l'algorithme de Dijkstra.
+ */
+typedef enum
+{
+  DIJKSTRA_MOTEUR_TAS,   // Tas d-aire, en O(E log V)
+  DIJKSTRA_MOTEUR_SEAUX, // Seaux de Dial, exploitant les couts entiers bornes, en O(V + E)
+  DIJKSTRA_MOTEUR_ASTAR, // A* sur tas, guide vers la destination par la distance Manhattan
+  DIJKSTRA_MOTEUR_BIDIRECTIONNEL // Deux recherches sur tas, depuis le depart et depuis la destination, arretees quand elles se rejoignent
+} t_dijkstra_moteur;
+
+/**
+ * @brief Un troncon de chemin : des deplacements consecutifs dans la meme direction.
+ * Un chemin complet s'ecrit comme une suite de troncons (codage par plages).
+ */
+typedef struct
+{
+  t_direction direction; // La direction des deplacements du troncon
+  int longueur;          // Le nombre de deplacements du troncon
+} t_dijkstra_troncon;
+
+/**
+ * @brief Contexte de recherche reutilisable entre plusieurs calculs de plus court chemin
+ * sur des terrains de memes dimensions. Son etat par case est remis a zero en temps constant
+ * d'une recherche a l'autre : seules les cases touchees par une recherche lui coutent.
+ */
+typedef struct s_dijkstra_contexte t_dijkstra_contexte;
+
 // ************************************
 // Declarations des fonctions publiques
 // ************************************
 
+/**
+ * @brief Choisit le moteur par defaut : celui des contextes crees ensuite, et des calculs faits sans
+ * contexte. Les contextes deja crees gardent leur moteur. A appeler avant de lancer des fils qui creent
+ * des contextes ou calculent sans contexte : le moteur par defaut n'est pas protege des acces concurrents.
+ * @name dijkstra_choisir_moteur
+ * @param moteur le moteur a utiliser (DIJKSTRA_MOTEUR_TAS par defaut)
+ */
+void dijkstra_choisir_moteur(t_dijkstra_moteur moteur);
+
+/**
+ * @brief Choisit la file de priorite utilisee par les calculs suivants faits avec un contexte.
+ * @name dijkstra_contexte_choisir_moteur
+ * @param contexte le contexte
+ * @param moteur le moteur a utiliser
+ */
+void dijkstra_contexte_choisir_moteur(t_dijkstra_contexte *contexte, t_dijkstra_moteur moteur);
+
+/**
+ * @brief Alloue un contexte de recherche aux dimensions d'un terrain, avec le moteur par defaut.
+ * @name dijkstra_contexte_creer
+ * @param terrain un terrain aux dimensions des terrains sur lesquels porteront les recherches
+ * @return le contexte alloue, NULL si la memoire manque
+ */
+t_dijkstra_contexte *dijkstra_contexte_creer(const t_terrain *terrain);
+
+/**
+ * @brief Libere un contexte de recherche.
+ * @name dijkstra_contexte_detruire
+ * @param contexte le contexte a liberer (peut etre NULL)
+ */
+void dijkstra_contexte_detruire(t_dijkstra_contexte *contexte);
+
+/**
+ * @brief Calcule le cout en carburant du plus court chemin entre deux cases avec le moteur du contexte.
+ * Tous les moteurs retournent le meme cout optimal ; seul le nombre de cases developpees change.
+ * @name dijkstra_calculer_cout
+ * @param contexte le contexte de recherche a reutiliser, NULL pour en allouer un le temps de l'appel
+ * @param terrain le terrain sur lequel chercher le chemin
+ * @param depart_ligne la ligne de la case de depart
+ * @param depart_colonne la colonne de la case de depart
+ * @param destination_ligne la ligne de la case a atteindre
+ * @param destination_colonne la colonne de la case a atteindre
+ * @param nb_expansions l'adresse ou deposer le nombre de cases developpees par la recherche, -1 si la memoire
+ * a manque (peut etre NULL)
+ * @return le cout du plus court chemin, -1 si la destination est inaccessible ou si la memoire manque
+ */
+int dijkstra_calculer_cout(t_dijkstra_contexte *contexte, const t_terrain *terrain, int depart_ligne, int depart_colonne, int destination_ligne, int destination_colonne, int *nb_expansions);
+
+/**
+ * @brief Calcule le plus court chemin complet entre deux cases, avec le moteur du contexte.
+ * Le chemin est donne du depart a la destination sous forme de troncons.
+ * @name dijkstra_calculer_chemin
+ * @param contexte le contexte de recherche a reutiliser, NULL pour en allouer un le temps de l'appel
+ * @param terrain le terrain sur lequel chercher le chemin
+ * @param depart_ligne la ligne de la case de depart
+ * @param depart_colonne la colonne de la case de depart
+ * @param destination_ligne la ligne de la case a atteindre
+ * @param destination_colonne la colonne de la case a atteindre
+ * @param troncons le tableau ou deposer les premiers troncons du chemin
+ * @param nb_max le nombre maximal de troncons a deposer
+ * @param cout l'adresse ou deposer le cout du chemin, -1 si la destination est inaccessible (peut etre NULL)
+ * @return le nombre de troncons du chemin complet, -1 si la destination est inaccessible ou si la memoire
+ * manque. S'il depasse nb_max, seuls les nb_max premiers troncons sont deposes.
+ */
+int dijkstra_calculer_chemin(t_dijkstra_contexte *contexte, const t_terrain *terrain, int depart_ligne, int depart_colonne, int destination_ligne, int destination_colonne, t_dijkstra_troncon troncons[], int nb_max, int *cout);
+
 /**
  * @brief Achete un bonus au prix de 10L de carburant et affiche les 4 premieres
  * directions du chemin qui utilise le moins de carburant.
  * @name dijkstra_acheter_bonus
+ * @param contexte le contexte de recherche a reutiliser, NULL pour en allouer un le temps de l'appel
  * @param terrain le terrain sur lequel proposer un debut de chemin optimal
  * @param joueur_ligne la ligne ou se trouve le joueur
  * @param joueur_colonne la colonne ou se trouve le joueur
@@ -25,6 +124,14 @@
  * @note Le debut de chemin propose ne garantit pas que le joueur pourra l'emprunter.
  * Cela depend de la quantite de carburant qu'il lui reste.
  */
-void dijkstra_acheter_bonus(const t_terrain terrain, int joueur_ligne, int joueur_colonne, int *joueur_carburant, int destination_ligne, int destination_colonne);
+void dijkstra_acheter_bonus(t_dijkstra_contexte *contexte, const t_terrain *terrain, int joueur_ligne, int joueur_colonne, int *joueur_carburant, int destination_ligne, int destination_colonne);
+
+/**
+ * @brief Affiche les premieres directions a suivre sur le plus court chemin pour joindre la destination a partir de la position du joueur
+ * @name dijkstra_afficher_directions_suggerees
+ * @param directions les premieres directions a suivre sur le plus court chemin
+ * @param nb le nombre de directions a suivre
+ */
+void dijkstra_afficher_directions_suggerees(const t_direction directions[], int nb);
 
 #endif // CODE_DIJKSTRA_H
\ No newline at end of file
@@ -0,0 +1,353 @@
+#define _POSIX_C_SOURCE 200809L // Pour sysconf
+#include "evaluation.h"
+#include "dijkstra.h" // Pour le chemin le moins couteux de evaluation_politique_dijkstra
+#include "util.h"     // Pour ABS, MIN et MAX
+#include <limits.h>
+#include <pthread.h>
+#include <stdatomic.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <unistd.h>
+
+// ****************************
+// Definitions des types prives
+// ****************************
+// Type pour une serie de parties en cours, partagee par tous les fils
+typedef struct
+{
+  const t_evaluation_parametres *parametres; // Les reglages de la serie
+  const t_evaluation_politique *politique;   // La politique qui joue les parties
+  atomic_int prochaine;                      // La premiere partie qui n'a pas encore ete prise
+} t_serie;
+
+// Type pour un fil d'execution de la serie et le bilan des parties qu'il a jouees
+typedef struct
+{
+  pthread_t identifiant;         // L'identifiant du fil (inutilise pour le fil appelant)
+  t_serie *serie;                // La serie a laquelle participe le fil
+  t_evaluation_rapport rapport;  // Le bilan des parties jouees par ce fil
+  bool reussi;                   // Indique que le fil a pu jouer ses parties
+} t_evaluateur;
+
+// **********************************
+// Declarations des fonctions privees
+// **********************************
+/**
+ * @brief Boucle d'un fil : prend des paquets de parties tant qu'il en reste et les joue sur un terrain
+ * qui lui est propre.
+ * @name executer_evaluateur
+ * @param argument l'evaluateur (t_evaluateur *)
+ * @return NULL
+ */
+void *executer_evaluateur(void *argument);
+
+/**
+ * @brief Tire puis joue une partie de la serie, et l'ajoute au bilan ; une partie dont le carburant
+ * n'a pas pu etre reparti n'est pas jouee et n'est comptee que dans nb_non_preparees.
+ * @name jouer_partie
+ * @param serie la serie
+ * @param terrain le terrain sur lequel tirer la partie, aux dimensions de la serie
+ * @param numero le numero de la partie, dont est tire son generateur
+ * @param etat l'etat de la politique propre au fil
+ * @param rapport le bilan auquel ajouter la partie
+ * @return true si la partie a ete jouee, false si la memoire manque (le bilan est inchange)
+ */
+bool jouer_partie(t_serie *serie, t_terrain *terrain, int numero, void *etat, t_evaluation_rapport *rapport);
+
+/**
+ * @brief Vide un bilan.
+ * @name vider_rapport
+ * @param rapport le bilan a vider
+ */
+void vider_rapport(t_evaluation_rapport *rapport);
+
+/**
+ * @brief Ajoute un bilan partiel a un bilan.
+ * @name fusionner_rapports
+ * @param rapport le bilan a completer
+ * @param partiel le bilan a ajouter
+ */
+void fusionner_rapports(t_evaluation_rapport *rapport, const t_evaluation_rapport *partiel);
+
+// ***********************************
+// Definitions des fonctions publiques
+// ***********************************
+void evaluation_parametres_defaut(t_evaluation_parametres *parametres, int nb_parties, uint64_t graine)
+{
+  parametres->nb_parties = nb_parties;
+  parametres->nb_lignes = NB_LIGNES;
+  parametres->nb_colonnes = NB_COLONNES;
+  parametres->carburant_initial = JOUEUR_CARBURANT_INITIAL;
+  parametres->carburant_stations = TOTAL_CARBURANT_NIVEAU_1;
+  parametres->prix_bonus = SIMULATION_PRIX_BONUS;
+  parametres->nb_actions_max = 10000;
+  parametres->graine = graine;
+  parametres->nb_fils = 0;
+}
+
+bool evaluation_lancer(const t_evaluation_parametres *parametres, const t_evaluation_politique *politique, t_evaluation_rapport *rapport)
+{
+  if (parametres->nb_parties < 0 || parametres->nb_lignes <= 0 || parametres->nb_colonnes <= 0 ||
+      parametres->nb_actions_max < 0 || politique == NULL || politique->choisir == NULL)
+  {
+    return false;
+  }
+  int nb_fils = parametres->nb_fils;
+  if (nb_fils <= 0)
+  {
+    long nb_coeurs = sysconf(_SC_NPROCESSORS_ONLN);
+    nb_fils = nb_coeurs > 0 ? (int)MIN(nb_coeurs, INT_MAX) : 1;
+  }
+  t_evaluateur *evaluateurs = calloc((size_t)nb_fils, sizeof(t_evaluateur));
+  if (evaluateurs == NULL)
+  {
+    return false;
+  }
+
+  t_serie serie;
+  serie.parametres = parametres;
+  serie.politique = politique;
+  atomic_init(&serie.prochaine, 0);
+
+  // Le fil appelant est l'evaluateur 0 : la serie avance meme si aucun autre fil n'a pu demarrer
+  for (int i = 0; i < nb_fils; i++)
+  {
+    evaluateurs[i].serie = &serie;
+  }
+  int nb_demarres = 1;
+  while (nb_demarres < nb_fils &&
+         pthread_create(&evaluateurs[nb_demarres].identifiant, NULL, executer_evaluateur, &evaluateurs[nb_demarres]) == 0)
+  {
+    nb_demarres++;
+  }
+  executer_evaluateur(&evaluateurs[0]);
+
+  bool reussi = evaluateurs[0].reussi;
+  vider_rapport(rapport);
+  fusionner_rapports(rapport, &evaluateurs[0].rapport);
+  for (int i = 1; i < nb_demarres; i++)
+  {
+    pthread_join(evaluateurs[i].identifiant, NULL);
+    reussi &= evaluateurs[i].reussi;
+    fusionner_rapports(rapport, &evaluateurs[i].rapport);
+  }
+  free(evaluateurs);
+  return reussi;
+}
+
+void evaluation_afficher_rapport(const t_evaluation_rapport *rapport)
+{
+  if (rapport->nb_non_preparees > 0)
+  {
+    printf("Attention : %d parties ecartees, le carburant des stations n'a pas pu etre reparti sur le terrain\n", rapport->nb_non_preparees);
+  }
+  printf("Parties jouees : %d\n", rapport->nb_parties);
+  if (rapport->nb_parties == 0)
+  {
+    return;
+  }
+  printf("Victoires : %d (%.1f %%), pannes : %d, abandons : %d\n", rapport->nb_victoires,
+         100.0 * rapport->nb_victoires / rapport->nb_parties, rapport->nb_echecs, rapport->nb_abandons);
+  if (rapport->nb_victoires == 0)
+  {
+    return;
+  }
+
+  printf("Carburant restant a l'arrivee : moyenne %.2f, min %d, max %d\n",
+         (double)rapport->somme_carburant / rapport->nb_victoires, rapport->carburant_min, rapport->carburant_max);
+  for (int classe = 0; classe < EVALUATION_NB_CLASSES; classe++)
+  {
+    if (rapport->carburant_restant[classe] == 0)
+    {
+      continue;
+    }
+    int debut = classe * EVALUATION_LARGEUR_CLASSE;
+    if (classe < EVALUATION_NB_CLASSES - 1)
+    {
+      printf("  %3d a %3d L : %6.2f %%\n", debut, debut + EVALUATION_LARGEUR_CLASSE - 1,
+             100.0 * rapport->carburant_restant[classe] / rapport->nb_victoires);
+    }
+    else
+    {
+      printf("  %3d L et +  : %6.2f %%\n", debut, 100.0 * rapport->carburant_restant[classe] / rapport->nb_victoires);
+    }
+  }
+  printf("Pas jusqu'a la sortie : moyenne %.2f, min %d, max %d\n",
+         (double)rapport->somme_pas / rapport->nb_victoires, rapport->pas_min, rapport->pas_max);
+}
+
+t_simulation_action evaluation_politique_aleatoire(const t_simulation *simulation, t_alea *alea, void *etat)
+{
+  (void)simulation;
+  (void)etat;
+  return (t_simulation_action)alea_borne(alea, 4);
+}
+
+t_simulation_action evaluation_politique_gloutonne(const t_simulation *simulation, t_alea *alea, void *etat)
+{
+  (void)alea;
+  (void)etat;
+  int distance = ABS(simulation->joueur_ligne - simulation->destination_ligne) + ABS(simulation->joueur_colonne - simulation->destination_colonne);
+  t_simulation_action meilleure = SIMULATION_ACTION_DROITE;
+  int meilleur_carburant = -1;
+  for (int direction = DIRECTION_DROITE; direction <= DIRECTION_GAUCHE; direction++)
+  {
+    int ligne, colonne;
+    jeu_calculer_voisin(simulation->joueur_ligne, simulation->joueur_colonne, (t_direction)direction, &ligne, &colonne);
+    int carburant = terrain_get_carburant(simulation->terrain, ligne, colonne);
+    if (carburant > meilleur_carburant &&
+        ABS(ligne - simulation->destination_ligne) + ABS(colonne - simulation->destination_colonne) < distance)
+    {
+      meilleure = (t_simulation_action)direction;
+      meilleur_carburant = carburant;
+    }
+  }
+  return meilleure;
+}
+
+t_simulation_action evaluation_politique_dijkstra(const t_simulation *simulation, t_alea *alea, void *etat)
+{
+  (void)alea;
+  t_dijkstra_troncon troncon;
+  if (dijkstra_calculer_chemin(etat, simulation->terrain, simulation->joueur_ligne, simulation->joueur_colonne,
+                               simulation->destination_ligne, simulation->destination_colonne, &troncon, 1, NULL) <= 0)
+  {
+    return SIMULATION_ACTION_DROITE;
+  }
+  return (t_simulation_action)troncon.direction;
+}
+
+void *evaluation_politique_dijkstra_creer(const t_terrain *terrain)
+{
+  return dijkstra_contexte_creer(terrain);
+}
+
+void evaluation_politique_dijkstra_detruire(void *etat)
+{
+  dijkstra_contexte_detruire(etat);
+}
+
+// *********************************
+// Definitions des fonctions privees
+// *********************************
+void *executer_evaluateur(void *argument)
+{
+  t_evaluateur *evaluateur = argument;
+  t_serie *serie = evaluateur->serie;
+  const t_evaluation_parametres *parametres = serie->parametres;
+  vider_rapport(&evaluateur->rapport);
+
+  // Le terrain et l'etat de la politique sont propres au fil et servent a toutes ses parties
+  t_terrain *terrain = terrain_creer(parametres->nb_lignes, parametres->nb_colonnes);
+  void *etat = NULL;
+  if (terrain != NULL && serie->politique->creer_etat != NULL)
+  {
+    etat = serie->politique->creer_etat(terrain);
+    if (etat == NULL)
+    {
+      terrain_detruire(terrain);
+      terrain = NULL;
+    }
+  }
+  evaluateur->reussi = terrain != NULL;
+  if (terrain == NULL)
+  {
+    return NULL;
+  }
+
+  // Les paquets se prennent sans verrou : chaque partie n'est jouee que par un fil
+  int debut;
+  while ((debut = atomic_fetch_add(&serie->prochaine, EVALUATION_TAILLE_PAQUET)) < parametres->nb_parties)
+  {
+    int fin = MIN(debut + EVALUATION_TAILLE_PAQUET, parametres->nb_parties);
+    for (int numero = debut; numero < fin; numero++)
+    {
+      evaluateur->reussi &= jouer_partie(serie, terrain, numero, etat, &evaluateur->rapport);
+    }
+  }
+  if (serie->politique->detruire_etat != NULL)
+  {
+    serie->politique->detruire_etat(etat);
+  }
+  terrain_detruire(terrain);
+  return NULL;
+}
+
+bool jouer_partie(t_serie *serie, t_terrain *terrain, int numero, void *etat, t_evaluation_rapport *rapport)
+{
+  const t_evaluation_parametres *parametres = serie->parametres;
+  t_alea alea;
+  alea_init_flux(&alea, parametres->graine, (uint64_t)numero);
+
+  int joueur_ligne, joueur_colonne, joueur_carburant, destination_ligne, destination_colonne;
+  if (!jeu_preparer(terrain, &alea, parametres->carburant_initial, parametres->carburant_stations,
+                    &joueur_ligne, &joueur_colonne, &joueur_carburant, &destination_ligne, &destination_colonne))
+  {
+    // Un terrain qui ne porte qu'une partie du carburant fausserait le bilan : la partie est ecartee
+    rapport->nb_non_preparees++;
+    return true;
+  }
+  t_simulation simulation;
+  if (!simulation_reprendre(&simulation, terrain, joueur_ligne, joueur_colonne, joueur_carburant, destination_ligne, destination_colonne))
+  {
+    return false;
+  }
+  simulation.prix_bonus = parametres->prix_bonus;
+
+  for (int nb_actions = 0; simulation.etat == JEU_ETAT_EN_COURS && nb_actions < parametres->nb_actions_max; nb_actions++)
+  {
+    simulation_pas(&simulation, serie->politique->choisir(&simulation, &alea, etat));
+  }
+  simulation_liberer(&simulation);
+
+  rapport->nb_parties++;
+  if (simulation.etat == JEU_ETAT_VICTOIRE)
+  {
+    int carburant = simulation.joueur_carburant;
+    rapport->nb_victoires++;
+    rapport->carburant_restant[MIN(MAX(carburant, 0) / EVALUATION_LARGEUR_CLASSE, EVALUATION_NB_CLASSES - 1)]++;
+    rapport->somme_carburant += carburant;
+    rapport->carburant_min = MIN(rapport->carburant_min, carburant);
+    rapport->carburant_max = MAX(rapport->carburant_max, carburant);
+    rapport->somme_pas += simulation.nb_pas;
+    rapport->pas_min = MIN(rapport->pas_min, simulation.nb_pas);
+    rapport->pas_max = MAX(rapport->pas_max, simulation.nb_pas);
+  }
+  else if (simulation.etat == JEU_ETAT_ECHEC)
+  {
+    rapport->nb_echecs++;
+  }
+  else
+  {
+    rapport->nb_abandons++;
+  }
+  return true;
+}
+
+void vider_rapport(t_evaluation_rapport *rapport)
+{
+  *rapport = (t_evaluation_rapport){0};
+  rapport->carburant_min = INT_MAX;
+  rapport->carburant_max = INT_MIN;
+  rapport->pas_min = INT_MAX;
+  rapport->pas_max = INT_MIN;
+}
+
+void fusionner_rapports(t_evaluation_rapport *rapport, const t_evaluation_rapport *partiel)
+{
+  rapport->nb_parties += partiel->nb_parties;
+  rapport->nb_non_preparees += partiel->nb_non_preparees;
+  rapport->nb_victoires += partiel->nb_victoires;
+  rapport->nb_echecs += partiel->nb_echecs;
+  rapport->nb_abandons += partiel->nb_abandons;
+  for (int classe = 0; classe < EVALUATION_NB_CLASSES; classe++)
+  {
+    rapport->carburant_restant[classe] += partiel->carburant_restant[classe];
+  }
+  rapport->somme_carburant += partiel->somme_carburant;
+  rapport->carburant_min = MIN(rapport->carburant_min, partiel->carburant_min);
+  rapport->carburant_max = MAX(rapport->carburant_max, partiel->carburant_max);
+  rapport->somme_pas += partiel->somme_pas;
+  rapport->pas_min = MIN(rapport->pas_min, partiel->pas_min);
+  rapport->pas_max = MAX(rapport->pas_max, partiel->pas_max);
+}
@@ -0,0 +1,157 @@
+#ifndef CODE_EVALUATION_H
+#define CODE_EVALUATION_H
+
+#include <stdbool.h>    // Pour le type bool
+#include <stdint.h>     // Pour le type uint64_t
+#include "alea.h"       // Pour le type t_alea
+#include "simulation.h" // Pour les types t_simulation et t_simulation_action
+
+// Nombre de parties que prend un fil a chaque fois qu'il vient chercher du travail
+#define EVALUATION_TAILLE_PAQUET 16
+
+// Nombre de classes de l'histogramme du carburant restant a l'arrivee
+#define EVALUATION_NB_CLASSES 32
+
+// Largeur d'une classe de l'histogramme, en litres ; la derniere classe recoit aussi tout ce qui depasse
+#define EVALUATION_LARGEUR_CLASSE 4
+
+// *****************************
+// Definitions des types publics
+// *****************************
+
+/**
+ * @brief Les reglages d'une serie de parties.
+ */
+typedef struct
+{
+  int nb_parties;         // Le nombre de parties a jouer
+  int nb_lignes;          // Le nombre de lignes de chaque terrain
+  int nb_colonnes;        // Le nombre de colonnes de chaque terrain
+  int carburant_initial;  // Le carburant du joueur au depart
+  int carburant_stations; // La quantite globale de carburant repartie sur les stations
+  int prix_bonus;         // Le prix d'un bonus de deplacement
+  int nb_actions_max;     // Le nombre d'actions demandees a la politique au-dela duquel une partie est abandonnee
+  uint64_t graine;        // La graine maitresse : la partie numero i est tiree de alea_init_flux(graine, i)
+  int nb_fils;            // Le nombre de fils d'execution, 0 pour un par coeur disponible
+} t_evaluation_parametres;
+
+/**
+ * @brief Une politique de jeu. La fonction choisir donne l'action a jouer dans l'etat courant d'une
+ * partie ; une action refusee par la simulation est simplement perdue et la politique est rappelee.
+ * Les politiques sont appelees depuis plusieurs fils a la fois : chaque fil cree son propre etat
+ * avec creer_etat (par exemple un contexte de recherche), le passe a choisir pour toutes ses
+ * parties puis le detruit. Une politique sans etat laisse creer_etat et detruire_etat a NULL et
+ * recoit un etat NULL. Exemple : {evaluation_politique_dijkstra, evaluation_politique_dijkstra_creer,
+ * evaluation_politique_dijkstra_detruire}.
+ */
+typedef struct
+{
+  t_simulation_action (*choisir)(const t_simulation *simulation, t_alea *alea, void *etat); // Choisit l'action a jouer
+  void *(*creer_etat)(const t_terrain *terrain); // Cree l'etat d'un fil pour des terrains aux dimensions de celui-ci, NULL si la memoire manque
+  void (*detruire_etat)(void *etat);             // Detruit l'etat d'un fil
+} t_evaluation_politique;
+
+/**
+ * @brief Le bilan d'une serie de parties. Il ne depend que des reglages et de la politique, pas du
+ * nombre de fils ni de l'ordre dans lequel les parties ont ete jouees.
+ */
+typedef struct
+{
+  int nb_parties;                                     // Le nombre de parties jouees
+  int nb_non_preparees;                               // Le nombre de parties ecartees sans etre jouees, leurs stations n'ayant pas pu recevoir tout le carburant
+  int nb_victoires;                                   // Le nombre de parties ou le joueur a atteint la sortie
+  int nb_echecs;                                      // Le nombre de parties ou le joueur est tombe en panne
+  int nb_abandons;                                    // Le nombre de parties arretees apres nb_actions_max actions
+  long long carburant_restant[EVALUATION_NB_CLASSES]; // Pour chaque classe, le nombre de victoires avec ce carburant restant
+  long long somme_carburant;                          // La somme du carburant restant sur les victoires
+  int carburant_min;                                  // Le plus petit carburant restant sur une victoire
+  int carburant_max;                                  // Le plus grand carburant restant sur une victoire
+  long long somme_pas;                                // La somme des deplacements et bonus joues jusqu'a la sortie sur les victoires
+  int pas_min;                                        // Le plus petit nombre de pas d'une victoire
+  int pas_max;                                        // Le plus grand nombre de pas d'une victoire
+} t_evaluation_rapport;
+
+// ************************************
+// Declarations des fonctions publiques
+// ************************************
+
+/**
+ * @brief Remplit des reglages avec ceux du jeu interactif : terrain par defaut et constantes du niveau 1.
+ * @name evaluation_parametres_defaut
+ * @param parametres les reglages a remplir
+ * @param nb_parties le nombre de parties a jouer
+ * @param graine la graine maitresse
+ */
+void evaluation_parametres_defaut(t_evaluation_parametres *parametres, int nb_parties, uint64_t graine);
+
+/**
+ * @brief Joue une serie de parties en parallele et en dresse le bilan. Chaque partie est tiree
+ * comme par jeu_init (avec les quantites des reglages) dans son propre generateur, puis jouee par
+ * la politique jusqu'a la victoire, la panne ou l'abandon. Une partie dont les stations ne peuvent pas
+ * recevoir tout carburant_stations n'est pas jouee : elle est comptee a part dans nb_non_preparees et
+ * n'entre dans aucune autre statistique. Les fils se partagent les parties par
+ * paquets de EVALUATION_TAILLE_PAQUET, pris au fur et a mesure ; le fil appelant joue aussi.
+ * @name evaluation_lancer
+ * @param parametres les reglages de la serie
+ * @param politique la politique qui joue toutes les parties
+ * @param rapport l'adresse ou deposer le bilan
+ * @return true si toutes les parties ont ete jouees ou ecartees, false si les reglages sont invalides ou si la memoire manque
+ */
+bool evaluation_lancer(const t_evaluation_parametres *parametres, const t_evaluation_politique *politique, t_evaluation_rapport *rapport);
+
+/**
+ * @brief Affiche un bilan : taux de victoire, repartition du carburant restant et nombre de pas jusqu'a la
+ * sortie, precede d'un avertissement si des parties n'ont pas pu etre preparees.
+ * @name evaluation_afficher_rapport
+ * @param rapport le bilan a afficher
+ */
+void evaluation_afficher_rapport(const t_evaluation_rapport *rapport);
+
+/**
+ * @brief Politique qui se deplace au hasard, sans jamais acheter de bonus.
+ * @name evaluation_politique_aleatoire
+ * @param simulation la partie en cours
+ * @param alea le generateur de la partie
+ * @param etat inutilise, la politique n'a pas d'etat
+ * @return un deplacement tire au hasard
+ */
+t_simulation_action evaluation_politique_aleatoire(const t_simulation *simulation, t_alea *alea, void *etat);
+
+/**
+ * @brief Politique gloutonne : parmi les deplacements qui rapprochent de la sortie, prend celui qui
+ * mene a la case la plus riche en carburant.
+ * @name evaluation_politique_gloutonne
+ * @param simulation la partie en cours
+ * @param alea le generateur de la partie (inutilise)
+ * @param etat inutilise, la politique n'a pas d'etat
+ * @return le deplacement choisi
+ */
+t_simulation_action evaluation_politique_gloutonne(const t_simulation *simulation, t_alea *alea, void *etat);
+
+/**
+ * @brief Politique qui suit le chemin le moins couteux vers la sortie, recalcule a chaque pas.
+ * @name evaluation_politique_dijkstra
+ * @param simulation la partie en cours
+ * @param alea le generateur de la partie (inutilise)
+ * @param etat le contexte de recherche du fil, cree par evaluation_politique_dijkstra_creer
+ * @return le premier deplacement du chemin le moins couteux
+ */
+t_simulation_action evaluation_politique_dijkstra(const t_simulation *simulation, t_alea *alea, void *etat);
+
+/**
+ * @brief Cree l'etat d'un fil pour evaluation_politique_dijkstra : un contexte de recherche, reutilise
+ * a chaque pas de toutes les parties du fil.
+ * @name evaluation_politique_dijkstra_creer
+ * @param terrain un terrain aux dimensions des parties
+ * @return le contexte (t_dijkstra_contexte *), NULL si la memoire manque
+ */
+void *evaluation_politique_dijkstra_creer(const t_terrain *terrain);
+
+/**
+ * @brief Detruit l'etat d'un fil cree par evaluation_politique_dijkstra_creer.
+ * @name evaluation_politique_dijkstra_detruire
+ * @param etat le contexte de recherche
+ */
+void evaluation_politique_dijkstra_detruire(void *etat);
+
+#endif // CODE_EVALUATION_H
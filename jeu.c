@@ -15,7 +15,7 @@
  * @param joueur_carburant l'adresse où placer la nouvelle quantité de carburant du joueur après déplacement
  * @param terrain le terrain sur lequel le joueur s'est déplacé
  */
-void jeu_maj_carburant_joueur(int joueur_ligne, int joueur_colonne, int *joueur_carburant, t_terrain terrain)
+void jeu_maj_carburant_joueur(int joueur_ligne, int joueur_colonne, int *joueur_carburant, t_terrain *terrain)
 {
   // Récupérer le carburant sur la case actuelle
   int carburant_case = terrain_get_carburant(terrain, joueur_ligne, joueur_colonne);
@@ -35,9 +35,10 @@ void jeu_maj_carburant_joueur(int joueur_ligne, int joueur_colonne, int *joueur_
  * @param joueur_ligne l'adresse de la ligne où se trouve le joueur avant le déplacement et qui sera mise à jour
  * @param joueur_colonne l'adresse de la colonne où se trouve le joueur avant le déplacement et qui sera mise à jour
  * @param direction la direction dans laquelle on veut déplacer le joueur
+ * @param terrain le terrain sur lequel le joueur se déplace
  * @return true si le déplacement a pu se faire dans les limites du terrain, false sinon
  */
-bool jeu_deplacer_joueur(int *joueur_ligne, int *joueur_colonne, t_direction direction)
+bool jeu_deplacer_joueur(int *joueur_ligne, int *joueur_colonne, t_direction direction, const t_terrain *terrain)
 {
   int nouvelle_ligne = *joueur_ligne;
   int nouvelle_colonne = *joueur_colonne;
@@ -62,7 +63,7 @@ bool jeu_deplacer_joueur(int *joueur_ligne, int *joueur_colonne, t_direction dir
   }
 
   // Vérifier si la nouvelle position est valide
-  if (terrain_contient(nouvelle_ligne, nouvelle_colonne))
+  if (terrain_contient(terrain, nouvelle_ligne, nouvelle_colonne))
   {
     *joueur_ligne = nouvelle_ligne;
     *joueur_colonne = nouvelle_colonne;
@@ -75,29 +76,49 @@ bool jeu_deplacer_joueur(int *joueur_ligne, int *joueur_colonne, t_direction dir
 /**
  * @brief Initialise le terrain de jeu avec les stations de carburant.
  * Initialise la position de destination ainsi que la position initiale du joueur et sa quantité de carburant.
- * @param terrain le terrain sur lequel seront placées les stations de carburant
+ * @param terrain le terrain, déjà alloué à ses dimensions, sur lequel seront placées les stations de carburant
+ * @param alea le générateur dans lequel tirer les positions et les stations
  * @param joueur_ligne l'adresse de la ligne où positionner le joueur
  * @param joueur_colonne l'adresse de la colonne où positionner le joueur
  * @param joueur_carburant l'adresse où placer la quantité de carburant du joueur
  * @param destination_ligne l'adresse de la ligne de la case à atteindre
  * @param destination_colonne l'adresse de la colonne de la case à atteindre
+ * @return true si la partie est prête, false si tout le carburant n'a pas pu être réparti sur les stations
  */
-void jeu_init(t_terrain terrain, int *joueur_ligne, int *joueur_colonne, int *joueur_carburant, int *destination_ligne, int *destination_colonne)
+bool jeu_init(t_terrain *terrain, t_alea *alea, int *joueur_ligne, int *joueur_colonne, int *joueur_carburant, int *destination_ligne, int *destination_colonne)
+{
+  return jeu_preparer(terrain, alea, JOUEUR_CARBURANT_INITIAL, TOTAL_CARBURANT_NIVEAU_1, joueur_ligne, joueur_colonne, joueur_carburant, destination_ligne, destination_colonne);
+}
+
+/**
+ * @brief Prépare une partie comme jeu_init, avec des quantités de carburant données plutôt que celles du niveau 1.
+ * @param terrain le terrain, déjà alloué à ses dimensions, sur lequel seront placées les stations de carburant
+ * @param alea le générateur dans lequel tirer les positions et les stations
+ * @param carburant_initial la quantité de carburant du joueur au départ
+ * @param carburant_stations la quantité globale de carburant à répartir sur les stations
+ * @param joueur_ligne l'adresse de la ligne où positionner le joueur
+ * @param joueur_colonne l'adresse de la colonne où positionner le joueur
+ * @param joueur_carburant l'adresse où placer la quantité de carburant du joueur
+ * @param destination_ligne l'adresse de la ligne de la case à atteindre
+ * @param destination_colonne l'adresse de la colonne de la case à atteindre
+ * @return true si la partie est prête, false si tout le carburant n'a pas pu être réparti sur les stations
+ */
+bool jeu_preparer(t_terrain *terrain, t_alea *alea, int carburant_initial, int carburant_stations, int *joueur_ligne, int *joueur_colonne, int *joueur_carburant, int *destination_ligne, int *destination_colonne)
 {
   // Initialiser le terrain
   terrain_init(terrain);
 
   // Générer la position de sortie
-  terrain_generer_position_sortie(destination_ligne, destination_colonne);
+  terrain_generer_position_sortie(terrain, alea, destination_ligne, destination_colonne);
 
   // Générer la position de départ
-  terrain_generer_position_depart(*destination_ligne, *destination_colonne, joueur_ligne, joueur_colonne);
+  terrain_generer_position_depart(terrain, alea, *destination_ligne, *destination_colonne, joueur_ligne, joueur_colonne);
 
   // Initialiser le carburant du joueur
-  *joueur_carburant = JOUEUR_CARBURANT_INITIAL;
+  *joueur_carburant = carburant_initial;
 
   // Créer les stations de carburant
-  terrain_creer_stations_carburant(terrain, TOTAL_CARBURANT_NIVEAU_1);
+  return terrain_creer_stations_carburant(terrain, alea, carburant_stations);
 }
 
 /**
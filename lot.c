@@ -0,0 +1,199 @@
+#include "lot.h"
+#include "dijkstra.h" // Pour le calcul de chaque requete
+#include <pthread.h>
+#include <stdatomic.h>
+#include <stdbool.h>
+#include <stdlib.h>
+
+// ****************************
+// Definitions des types prives
+// ****************************
+// Type pour un fil d'execution de la reserve et son espace de travail
+typedef struct
+{
+  pthread_t identifiant;         // L'identifiant du fil
+  t_lot *lot;                    // La reserve a laquelle appartient le fil
+  t_dijkstra_contexte *contexte; // Le contexte de recherche propre au fil
+} t_fil;
+
+struct s_lot
+{
+  const t_terrain *terrain;          // Le terrain partage par toutes les requetes
+  int nb_fils;                       // Le nombre de fils demarres
+  t_fil *fils;                       // Les fils de la reserve
+  pthread_mutex_t verrou;            // Protege les champs ci-dessous, hormis prochaine
+  pthread_cond_t travail_disponible; // Signale un nouveau lot ou l'arret de la reserve
+  pthread_cond_t travail_termine;    // Signale que le dernier fil a fini le lot courant
+  const t_lot_requete *requetes;     // Les requetes du lot courant
+  t_lot_resultat *resultats;         // Les resultats du lot courant
+  int nb_requetes;                   // Le nombre de requetes du lot courant
+  atomic_int prochaine;              // La premiere requete du lot courant qui n'a pas encore ete prise
+  int nb_fils_actifs;                // Le nombre de fils qui travaillent encore sur le lot courant
+  unsigned numero_lot;               // Le numero du lot courant, pour que chaque fil ne le traite qu'une fois
+  bool arret;                        // Indique que les fils doivent s'arreter
+};
+
+// **********************************
+// Declarations des fonctions privees
+// **********************************
+/**
+ * @brief Boucle d'un fil : attend un lot, en traite des paquets de requetes tant qu'il en reste, recommence.
+ * @name executer_fil
+ * @param argument le fil (t_fil *)
+ * @return NULL
+ */
+void *executer_fil(void *argument);
+
+/**
+ * @brief Arrete et attend les nb premiers fils d'une reserve, puis libere la reserve.
+ * @name arreter_fils
+ * @param lot la reserve
+ * @param nb le nombre de fils demarres
+ */
+void arreter_fils(t_lot *lot, int nb);
+
+// ***********************************
+// Definitions des fonctions publiques
+// ***********************************
+t_lot *lot_creer(const t_terrain *terrain, int nb_fils)
+{
+  if (nb_fils < 1)
+  {
+    return NULL;
+  }
+
+  t_lot *lot = malloc(sizeof(t_lot));
+  if (lot == NULL)
+  {
+    return NULL;
+  }
+  lot->fils = calloc((size_t)nb_fils, sizeof(t_fil));
+  if (lot->fils == NULL)
+  {
+    free(lot);
+    return NULL;
+  }
+
+  lot->terrain = terrain;
+  lot->nb_fils = nb_fils;
+  lot->requetes = NULL;
+  lot->resultats = NULL;
+  lot->nb_requetes = 0;
+  atomic_init(&lot->prochaine, 0);
+  lot->nb_fils_actifs = 0;
+  lot->numero_lot = 0;
+  lot->arret = false;
+  pthread_mutex_init(&lot->verrou, NULL);
+  pthread_cond_init(&lot->travail_disponible, NULL);
+  pthread_cond_init(&lot->travail_termine, NULL);
+
+  for (int i = 0; i < nb_fils; i++)
+  {
+    lot->fils[i].lot = lot;
+    lot->fils[i].contexte = dijkstra_contexte_creer(terrain);
+    if (lot->fils[i].contexte == NULL ||
+        pthread_create(&lot->fils[i].identifiant, NULL, executer_fil, &lot->fils[i]) != 0)
+    {
+      dijkstra_contexte_detruire(lot->fils[i].contexte);
+      arreter_fils(lot, i);
+      return NULL;
+    }
+  }
+  return lot;
+}
+
+void lot_detruire(t_lot *lot)
+{
+  if (lot != NULL)
+  {
+    arreter_fils(lot, lot->nb_fils);
+  }
+}
+
+void lot_calculer(t_lot *lot, const t_lot_requete requetes[], int nb_requetes, t_lot_resultat resultats[])
+{
+  pthread_mutex_lock(&lot->verrou);
+  lot->requetes = requetes;
+  lot->resultats = resultats;
+  lot->nb_requetes = nb_requetes;
+  atomic_store(&lot->prochaine, 0);
+  lot->nb_fils_actifs = lot->nb_fils;
+  lot->numero_lot++;
+  pthread_cond_broadcast(&lot->travail_disponible);
+
+  while (lot->nb_fils_actifs > 0)
+  {
+    pthread_cond_wait(&lot->travail_termine, &lot->verrou);
+  }
+  pthread_mutex_unlock(&lot->verrou);
+}
+
+// *********************************
+// Definitions des fonctions privees
+// *********************************
+void *executer_fil(void *argument)
+{
+  t_fil *fil = argument;
+  t_lot *lot = fil->lot;
+  unsigned dernier_lot = 0;
+
+  pthread_mutex_lock(&lot->verrou);
+  while (true)
+  {
+    while (!lot->arret && lot->numero_lot == dernier_lot)
+    {
+      pthread_cond_wait(&lot->travail_disponible, &lot->verrou);
+    }
+    if (lot->arret)
+    {
+      break;
+    }
+    dernier_lot = lot->numero_lot;
+    const t_lot_requete *requetes = lot->requetes;
+    t_lot_resultat *resultats = lot->resultats;
+    int nb_requetes = lot->nb_requetes;
+    pthread_mutex_unlock(&lot->verrou);
+
+    // Les paquets se prennent sans verrou : chaque requete n'est traitee que par un fil
+    int debut;
+    while ((debut = atomic_fetch_add(&lot->prochaine, LOT_TAILLE_PAQUET)) < nb_requetes)
+    {
+      int fin = debut + LOT_TAILLE_PAQUET < nb_requetes ? debut + LOT_TAILLE_PAQUET : nb_requetes;
+      for (int i = debut; i < fin; i++)
+      {
+        const t_lot_requete *requete = &requetes[i];
+        resultats[i].cout = dijkstra_calculer_cout(fil->contexte, lot->terrain, requete->depart_ligne, requete->depart_colonne,
+                                                   requete->destination_ligne, requete->destination_colonne, &resultats[i].nb_expansions);
+      }
+    }
+
+    pthread_mutex_lock(&lot->verrou);
+    lot->nb_fils_actifs--;
+    if (lot->nb_fils_actifs == 0)
+    {
+      pthread_cond_signal(&lot->travail_termine);
+    }
+  }
+  pthread_mutex_unlock(&lot->verrou);
+  return NULL;
+}
+
+void arreter_fils(t_lot *lot, int nb)
+{
+  pthread_mutex_lock(&lot->verrou);
+  lot->arret = true;
+  pthread_cond_broadcast(&lot->travail_disponible);
+  pthread_mutex_unlock(&lot->verrou);
+
+  for (int i = 0; i < nb; i++)
+  {
+    pthread_join(lot->fils[i].identifiant, NULL);
+    dijkstra_contexte_detruire(lot->fils[i].contexte);
+  }
+
+  pthread_cond_destroy(&lot->travail_termine);
+  pthread_cond_destroy(&lot->travail_disponible);
+  pthread_mutex_destroy(&lot->verrou);
+  free(lot->fils);
+  free(lot);
+}
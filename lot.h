@@ -0,0 +1,73 @@
+#ifndef CODE_LOT_H
+#define CODE_LOT_H
+
+#include "terrain.h" // Pour le type t_terrain
+
+// Nombre de requetes qu'un fil prend d'un coup dans le lot courant
+#define LOT_TAILLE_PAQUET 8
+
+// *****************************
+// Definitions des types publics
+// *****************************
+
+/**
+ * @brief Une requete de plus court chemin entre deux cases.
+ */
+typedef struct
+{
+  int depart_ligne;        // La ligne de la case de depart
+  int depart_colonne;      // La colonne de la case de depart
+  int destination_ligne;   // La ligne de la case a atteindre
+  int destination_colonne; // La colonne de la case a atteindre
+} t_lot_requete;
+
+/**
+ * @brief Le resultat d'une requete de plus court chemin.
+ */
+typedef struct
+{
+  int cout;          // Le cout du plus court chemin, -1 si la destination est inaccessible
+  int nb_expansions; // Le nombre de cases developpees par la recherche
+} t_lot_resultat;
+
+/**
+ * @brief Reserve de fils d'execution qui traitent des lots de requetes sur un meme terrain.
+ * Chaque fil garde son propre contexte de recherche ; le terrain est partage en lecture seule.
+ */
+typedef struct s_lot t_lot;
+
+// ************************************
+// Declarations des fonctions publiques
+// ************************************
+
+/**
+ * @brief Demarre une reserve de fils pour traiter des lots de requetes. Chaque fil a son contexte de
+ * recherche, cree avec le moteur par defaut du moment (voir dijkstra_choisir_moteur) qu'il garde
+ * jusqu'a la destruction de la reserve.
+ * @name lot_creer
+ * @param terrain le terrain des requetes, qui ne doit pas etre modifie pendant le traitement d'un lot
+ * @param nb_fils le nombre de fils d'execution (au moins 1)
+ * @return la reserve, NULL si la memoire manque ou si un fil n'a pas pu etre demarre
+ */
+t_lot *lot_creer(const t_terrain *terrain, int nb_fils);
+
+/**
+ * @brief Arrete les fils d'une reserve et la libere.
+ * @name lot_detruire
+ * @param lot la reserve a liberer (peut etre NULL)
+ */
+void lot_detruire(t_lot *lot);
+
+/**
+ * @brief Traite un lot de requetes avec le moteur choisi a la creation de la reserve et attend
+ * la fin du traitement. Les fils se partagent les requetes par paquets de LOT_TAILLE_PAQUET.
+ * Une meme reserve ne traite qu'un lot a la fois.
+ * @name lot_calculer
+ * @param lot la reserve
+ * @param requetes les requetes a traiter
+ * @param nb_requetes le nombre de requetes
+ * @param resultats le tableau ou deposer les resultats, dans l'ordre des requetes
+ */
+void lot_calculer(t_lot *lot, const t_lot_requete requetes[], int nb_requetes, t_lot_resultat resultats[]);
+
+#endif // CODE_LOT_H
@@ -3,10 +3,14 @@
 #include <time.h>
 #include "couleur.h"
 #include "util.h"
+#include "alea.h"
 #include "interaction.h"
 #include "jeu.h"
 #include "terrain.h"
-#include "dijkstra.h"
+#include "planificateur.h"
+#include "autonomie.h"
+#include "rendu.h"
+#include "minimap.h"
 
 // *********************************************
 // Declarations des fonctions autres que le main
@@ -16,35 +20,101 @@
  * @brief Exécute la boucle principale du jeu
  * @name jeu_executer
  * @param terrain le terrain sur lequel le joueur évolue
+ * @param planificateur le planificateur tenu à jour des déplacements, qui sert à chaque achat de bonus
+ * @param autonomie l'espace de travail des chemins praticables, tenu à jour des déplacements
+ * @param rendu le moteur d'affichage du terrain, NULL pour afficher avec terrain_afficher
+ * @param minimap la pyramide de la minicarte, tenue à jour des déplacements, NULL sans minicarte
  * @param joueur_ligne la ligne où se trouve le joueur
  * @param joueur_colonne la colonne où se trouve le joueur
  * @param joueur_carburant la quantité de carburant du joueur
  * @param destination_ligne la ligne de la case à atteindre
  * @param destination_colonne la colonne de la case à atteindre
  */
-void jeu_executer(t_terrain terrain, int joueur_ligne, int joueur_colonne, int joueur_carburant, int destination_ligne, int destination_colonne);
+void jeu_executer(t_terrain *terrain, t_planificateur *planificateur, t_autonomie *autonomie, t_rendu *rendu, t_minimap *minimap, int joueur_ligne, int joueur_colonne, int joueur_carburant, int destination_ligne, int destination_colonne);
 
 // ******************************
 // Definition de la fonction main
 // ******************************
-int main(void)
+int main(int argc, char *argv[])
 {
-    srand(time(NULL)); // Initialisation du générateur de nombres aléatoires
+    t_alea alea;
+    alea_init(&alea, (uint64_t)time(NULL)); // Initialisation du générateur de nombres aléatoires
+
+    // Dimensions du terrain : celles par défaut, ou celles passées en arguments (lignes colonnes)
+    int nb_lignes = NB_LIGNES;
+    int nb_colonnes = NB_COLONNES;
+    if (argc == 3)
+    {
+        nb_lignes = atoi(argv[1]);
+        nb_colonnes = atoi(argv[2]);
+    }
 
     // Les données du jeu : terrain, joueur, case de sortie
-    t_terrain terrain;
+    t_terrain *terrain = terrain_creer(nb_lignes, nb_colonnes);
+    if (terrain == NULL)
+    {
+        printf("Impossible de creer un terrain de %d x %d\n", nb_lignes, nb_colonnes);
+        return 1;
+    }
     int joueur_ligne, joueur_colonne, joueur_carburant; // Le joueur
     int destination_ligne, destination_colonne;         // La case de destination
 
     // Initialisation du jeu
-    jeu_init(terrain, &joueur_ligne, &joueur_colonne, &joueur_carburant, &destination_ligne, &destination_colonne);
+    if (!jeu_init(terrain, &alea, &joueur_ligne, &joueur_colonne, &joueur_carburant, &destination_ligne, &destination_colonne))
+    {
+        printf("Impossible de placer tout le carburant sur un terrain de %d x %d\n", nb_lignes, nb_colonnes);
+        terrain_detruire(terrain);
+        return 1;
+    }
+    t_planificateur *planificateur = planificateur_creer(terrain, joueur_ligne, joueur_colonne, destination_ligne, destination_colonne);
+    if (planificateur == NULL)
+    {
+        printf("Memoire insuffisante pour le calcul des bonus\n");
+        terrain_detruire(terrain);
+        return 1;
+    }
+    // Les distances à la sortie sont calculées une fois pour toute la partie
+    if (!planificateur_completer(planificateur))
+    {
+        printf("Memoire insuffisante pour le calcul des bonus\n");
+        planificateur_detruire(planificateur);
+        terrain_detruire(terrain);
+        return 1;
+    }
+    t_autonomie *autonomie = autonomie_creer(terrain);
+    if (autonomie == NULL)
+    {
+        printf("Memoire insuffisante pour le calcul des bonus\n");
+        planificateur_detruire(planificateur);
+        terrain_detruire(terrain);
+        return 1;
+    }
 
     // Présentation du jeu
     interaction_presenter_jeu();
 
+    // Affichage : une fenêtre autour du joueur, et une minicarte si le terrain la déborde ;
+    // sans mémoire pour le tampon d'affichage, on se contente de terrain_afficher
+    t_rendu *rendu = rendu_creer(RENDU_FENETRE_LIGNES, RENDU_FENETRE_COLONNES);
+    t_minimap *minimap = NULL;
+    if (rendu != NULL && (nb_lignes > RENDU_FENETRE_LIGNES || nb_colonnes > RENDU_FENETRE_COLONNES))
+    {
+        minimap = minimap_creer(terrain);
+        if (minimap != NULL && !rendu_activer_minimap(rendu, minimap, RENDU_MINIMAP_LIGNES, RENDU_MINIMAP_COLONNES, MINIMAP_SOMME))
+        {
+            minimap_detruire(minimap);
+            minimap = NULL;
+        }
+    }
+
     // Boucle principale du jeu
-    jeu_executer(terrain, joueur_ligne, joueur_colonne, joueur_carburant, destination_ligne, destination_colonne);
+    jeu_executer(terrain, planificateur, autonomie, rendu, minimap, joueur_ligne, joueur_colonne, joueur_carburant, destination_ligne, destination_colonne);
 
+    rendu_detruire(rendu);
+    minimap_detruire(minimap);
+    autonomie_detruire(autonomie);
+    planificateur_detruire(planificateur);
+    terrain_detruire(terrain);
     return 0;
 }
 
@@ -55,18 +125,25 @@ int main(void)
 /**
  * @brief Exécute la boucle principale du jeu
  * @param terrain le terrain sur lequel le joueur évolue
+ * @param planificateur le planificateur tenu à jour des déplacements, qui sert à chaque achat de bonus
+ * @param autonomie l'espace de travail des chemins praticables, tenu à jour des déplacements
+ * @param rendu le moteur d'affichage du terrain, NULL pour afficher avec terrain_afficher
+ * @param minimap la pyramide de la minicarte, tenue à jour des déplacements, NULL sans minicarte
  * @param joueur_ligne la ligne où se trouve le joueur
  * @param joueur_colonne la colonne où se trouve le joueur
  * @param joueur_carburant la quantité de carburant du joueur
  * @param destination_ligne la ligne de la case à atteindre
  * @param destination_colonne la colonne de la case à atteindre
  */
-void jeu_executer(t_terrain terrain, int joueur_ligne, int joueur_colonne, int joueur_carburant, int destination_ligne, int destination_colonne)
+void jeu_executer(t_terrain *terrain, t_planificateur *planificateur, t_autonomie *autonomie, t_rendu *rendu, t_minimap *minimap, int joueur_ligne, int joueur_colonne, int joueur_carburant, int destination_ligne, int destination_colonne)
 {
     while (1)
     {
         // Affichage du terrain
-        terrain_afficher(terrain, joueur_ligne, joueur_colonne, destination_ligne, destination_colonne);
+        if (rendu == NULL || !rendu_actualiser(rendu, terrain, joueur_ligne, joueur_colonne, destination_ligne, destination_colonne))
+        {
+            terrain_afficher(terrain, joueur_ligne, joueur_colonne, destination_ligne, destination_colonne);
+        }
 
         // Affichage des options
         interaction_afficher_options(joueur_carburant);
@@ -93,9 +170,18 @@ void jeu_executer(t_terrain terrain, int joueur_ligne, int joueur_colonne, int j
             }
 
             // Déplacement du joueur
-            if (jeu_deplacer_joueur(&joueur_ligne, &joueur_colonne, direction))
+            if (jeu_deplacer_joueur(&joueur_ligne, &joueur_colonne, direction, terrain))
             {
+                int ancien_carburant = terrain_get_carburant(terrain, joueur_ligne, joueur_colonne);
                 jeu_maj_carburant_joueur(joueur_ligne, joueur_colonne, &joueur_carburant, terrain);
+                autonomie_signaler_case_modifiee(autonomie, joueur_ligne, joueur_colonne, ancien_carburant);
+                // Faute de mémoire, le planificateur devient invalide et le prochain bonus le signalera
+                planificateur_signaler_case_modifiee(planificateur, joueur_ligne, joueur_colonne);
+                if (minimap != NULL)
+                {
+                    minimap_signaler_case_modifiee(minimap, joueur_ligne, joueur_colonne);
+                }
+                planificateur_deplacer_depart(planificateur, joueur_ligne, joueur_colonne);
                 printf("Deplacement reussi ! Nouvelle position : (%d, %d)\n", joueur_ligne, joueur_colonne);
                 printf("Nouveau carburant du joueur : %d\n\n", joueur_carburant);
             }
@@ -107,10 +193,21 @@ void jeu_executer(t_terrain terrain, int joueur_ligne, int joueur_colonne, int j
         }
         case ACTION_ACHETER_BONUS:
         {
-            // Achat du bonus de déplacement
+            // Achat du bonus de déplacement : le plus court chemin, lu dans le champ des distances
+            // du planificateur, s'il est praticable avec le carburant restant ; sinon un chemin
+            // praticable cherché sous la contrainte du carburant, et à défaut le plus court chemin
             if (joueur_carburant >= 10)
             {
-                dijkstra_acheter_bonus(terrain, joueur_ligne, joueur_colonne, &joueur_carburant, destination_ligne, destination_colonne);
+                int carburant_final = planificateur_carburant_arrivee(planificateur, joueur_carburant - 10);
+                if (carburant_final >= 0)
+                {
+                    planificateur_acheter_bonus(planificateur, &joueur_carburant);
+                    printf("Carburant a l'arrivee en suivant ce chemin : %d\n", carburant_final);
+                }
+                else if (!autonomie_acheter_bonus(autonomie, joueur_ligne, joueur_colonne, &joueur_carburant, destination_ligne, destination_colonne))
+                {
+                    planificateur_acheter_bonus(planificateur, &joueur_carburant);
+                }
             }
             else
             {
@@ -0,0 +1,159 @@
+#include "minimap.h"
+#include "util.h" // Pour MIN et MAX
+#include <stdint.h>
+#include <stdlib.h>
+
+// ****************************
+// Definitions des types prives
+// ****************************
+struct s_minimap
+{
+  const t_terrain *terrain;                  // Le terrain resume, qui sert de niveau 0
+  int nb_niveaux;                            // Le niveau le plus grossier, ou un seul bloc couvre tout le terrain
+  int nb_lignes[MINIMAP_NB_NIVEAUX_MAX];     // Pour chaque niveau, son nombre de lignes de blocs
+  int nb_colonnes[MINIMAP_NB_NIVEAUX_MAX];   // Pour chaque niveau, son nombre de colonnes de blocs
+  long long *sommes[MINIMAP_NB_NIVEAUX_MAX]; // Pour chaque niveau a partir de 1, le carburant total de chaque bloc
+  uint8_t *maxima[MINIMAP_NB_NIVEAUX_MAX];   // Pour chaque niveau a partir de 1, le carburant de la case la plus riche de chaque bloc
+};
+
+// **********************************
+// Declarations des fonctions privees
+// **********************************
+/**
+ * @brief Recalcule la somme et le maximum d'un bloc depuis les quatre blocs (au plus) du niveau du
+ * dessous, ou depuis les cases du terrain pour le niveau 1.
+ * @name recalculer_bloc
+ * @param minimap la pyramide
+ * @param niveau le niveau du bloc, a partir de 1
+ * @param ligne la ligne du bloc dans son niveau
+ * @param colonne la colonne du bloc dans son niveau
+ */
+void recalculer_bloc(t_minimap *minimap, int niveau, int ligne, int colonne);
+
+// ***********************************
+// Definitions des fonctions publiques
+// ***********************************
+t_minimap *minimap_creer(const t_terrain *terrain)
+{
+  t_minimap *minimap = calloc(1, sizeof(t_minimap));
+  if (minimap == NULL)
+  {
+    return NULL;
+  }
+  minimap->terrain = terrain;
+  minimap->nb_lignes[0] = terrain->nb_lignes;
+  minimap->nb_colonnes[0] = terrain->nb_colonnes;
+
+  // Chaque niveau divise les dimensions du precedent par deux, arrondi au-dessus, jusqu'a un seul bloc
+  int niveau = 0;
+  while (minimap->nb_lignes[niveau] > 1 || minimap->nb_colonnes[niveau] > 1)
+  {
+    niveau++;
+    minimap->nb_lignes[niveau] = (minimap->nb_lignes[niveau - 1] + 1) / 2;
+    minimap->nb_colonnes[niveau] = (minimap->nb_colonnes[niveau - 1] + 1) / 2;
+    size_t nb_blocs = (size_t)minimap->nb_lignes[niveau] * (size_t)minimap->nb_colonnes[niveau];
+    minimap->sommes[niveau] = malloc(nb_blocs * sizeof(long long));
+    minimap->maxima[niveau] = malloc(nb_blocs * sizeof(uint8_t));
+    minimap->nb_niveaux = niveau;
+    if (minimap->sommes[niveau] == NULL || minimap->maxima[niveau] == NULL)
+    {
+      minimap_detruire(minimap);
+      return NULL;
+    }
+    for (int i = 0; i < minimap->nb_lignes[niveau]; i++)
+    {
+      for (int j = 0; j < minimap->nb_colonnes[niveau]; j++)
+      {
+        recalculer_bloc(minimap, niveau, i, j);
+      }
+    }
+  }
+  return minimap;
+}
+
+void minimap_detruire(t_minimap *minimap)
+{
+  if (minimap == NULL)
+  {
+    return;
+  }
+  for (int niveau = 1; niveau <= minimap->nb_niveaux; niveau++)
+  {
+    free(minimap->sommes[niveau]);
+    free(minimap->maxima[niveau]);
+  }
+  free(minimap);
+}
+
+void minimap_signaler_case_modifiee(t_minimap *minimap, int ligne, int colonne)
+{
+  for (int niveau = 1; niveau <= minimap->nb_niveaux; niveau++)
+  {
+    recalculer_bloc(minimap, niveau, ligne >> niveau, colonne >> niveau);
+  }
+}
+
+int minimap_choisir_niveau(const t_minimap *minimap, int nb_lignes_max, int nb_colonnes_max, int *nb_lignes, int *nb_colonnes)
+{
+  int niveau = 0;
+  while (niveau < minimap->nb_niveaux &&
+         (minimap->nb_lignes[niveau] > nb_lignes_max || minimap->nb_colonnes[niveau] > nb_colonnes_max))
+  {
+    niveau++;
+  }
+  *nb_lignes = minimap->nb_lignes[niveau];
+  *nb_colonnes = minimap->nb_colonnes[niveau];
+  return niveau;
+}
+
+int minimap_intensite(const t_minimap *minimap, int niveau, int ligne, int colonne, t_minimap_mesure mesure)
+{
+  const t_terrain *terrain = minimap->terrain;
+  if (niveau == 0)
+  {
+    return MIN(terrain->cases[terrain_indice(terrain, ligne, colonne)], STATION_MAX_CARBURANT);
+  }
+  size_t bloc = (size_t)ligne * (size_t)minimap->nb_colonnes[niveau] + (size_t)colonne;
+  if (mesure == MINIMAP_MAX)
+  {
+    return MIN(minimap->maxima[niveau][bloc], STATION_MAX_CARBURANT);
+  }
+
+  // Les blocs du bord droit et du bas peuvent deborder du terrain : on ne compte que leurs vraies cases
+  long long hauteur = MIN(terrain->nb_lignes - ((long long)ligne << niveau), 1LL << niveau);
+  long long largeur = MIN(terrain->nb_colonnes - ((long long)colonne << niveau), 1LL << niveau);
+  long long nb_cases = hauteur * largeur;
+  long long moyenne = (minimap->sommes[niveau][bloc] + nb_cases - 1) / nb_cases;
+  return (int)MIN(moyenne, STATION_MAX_CARBURANT);
+}
+
+// *********************************
+// Definitions des fonctions privees
+// *********************************
+void recalculer_bloc(t_minimap *minimap, int niveau, int ligne, int colonne)
+{
+  const t_terrain *terrain = minimap->terrain;
+  long long somme = 0;
+  uint8_t maximum = 0;
+  for (int i = 2 * ligne; i < MIN(2 * ligne + 2, minimap->nb_lignes[niveau - 1]); i++)
+  {
+    for (int j = 2 * colonne; j < MIN(2 * colonne + 2, minimap->nb_colonnes[niveau - 1]); j++)
+    {
+      if (niveau == 1)
+      {
+        uint8_t carburant = terrain->cases[terrain_indice(terrain, i, j)];
+        somme += carburant;
+        maximum = MAX(maximum, carburant);
+      }
+      else
+      {
+        size_t dessous = (size_t)i * (size_t)minimap->nb_colonnes[niveau - 1] + (size_t)j;
+        somme += minimap->sommes[niveau - 1][dessous];
+        maximum = MAX(maximum, minimap->maxima[niveau - 1][dessous]);
+      }
+    }
+  }
+  size_t bloc = (size_t)ligne * (size_t)minimap->nb_colonnes[niveau] + (size_t)colonne;
+  minimap->sommes[niveau][bloc] = somme;
+  minimap->maxima[niveau][bloc] = maximum;
+}
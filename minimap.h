@@ -0,0 +1,83 @@
+#ifndef CODE_MINIMAP_H
+#define CODE_MINIMAP_H
+
+#include "terrain.h" // Pour le type t_terrain
+
+// Nombre maximal de niveaux de la pyramide : de quoi reduire tout terrain a une seule case
+#define MINIMAP_NB_NIVEAUX_MAX 32
+
+// *****************************
+// Definitions des types publics
+// *****************************
+
+/**
+ * @brief Ce que resume chaque case de la minicarte sur le bloc de cases du terrain qu'elle couvre.
+ */
+typedef enum
+{
+  MINIMAP_SOMME, // Le carburant du bloc rapporte a son nombre de cases, arrondi au-dessus
+  MINIMAP_MAX    // Le carburant de la case la plus riche du bloc
+} t_minimap_mesure;
+
+/**
+ * @brief Pyramide de resumes du carburant d'un terrain. Le niveau k decoupe le terrain en blocs de
+ * 2^k x 2^k cases et retient, pour chaque bloc, la somme et le maximum de leur carburant ; chaque
+ * niveau se calcule depuis les quatre blocs du niveau du dessous. Une case de la minicarte se lit
+ * donc en temps constant quel que soit le terrain, et une case modifiee ne coute qu'un bloc par niveau.
+ */
+typedef struct s_minimap t_minimap;
+
+// ************************************
+// Declarations des fonctions publiques
+// ************************************
+
+/**
+ * @brief Construit la pyramide d'un terrain, en un parcours de ses cases.
+ * @name minimap_creer
+ * @param terrain le terrain, qui doit rester alloue tant que la pyramide sert
+ * @return la pyramide, NULL si la memoire manque
+ */
+t_minimap *minimap_creer(const t_terrain *terrain);
+
+/**
+ * @brief Libere une pyramide.
+ * @name minimap_detruire
+ * @param minimap la pyramide a liberer (peut etre NULL)
+ */
+void minimap_detruire(t_minimap *minimap);
+
+/**
+ * @brief Indique a la pyramide que le carburant d'une case du terrain a change : le bloc qui la
+ * contient est recalcule a chaque niveau.
+ * @name minimap_signaler_case_modifiee
+ * @param minimap la pyramide
+ * @param ligne la ligne de la case modifiee
+ * @param colonne la colonne de la case modifiee
+ */
+void minimap_signaler_case_modifiee(t_minimap *minimap, int ligne, int colonne);
+
+/**
+ * @brief Choisit le niveau le plus fin dont les blocs tiennent dans une minicarte de taille donnee.
+ * @name minimap_choisir_niveau
+ * @param minimap la pyramide
+ * @param nb_lignes_max le nombre maximal de lignes de la minicarte (au moins 1)
+ * @param nb_colonnes_max le nombre maximal de colonnes de la minicarte (au moins 1)
+ * @param nb_lignes l'adresse ou deposer le nombre de lignes de blocs du niveau choisi
+ * @param nb_colonnes l'adresse ou deposer le nombre de colonnes de blocs du niveau choisi
+ * @return le niveau choisi : chaque bloc couvre 2^niveau x 2^niveau cases du terrain
+ */
+int minimap_choisir_niveau(const t_minimap *minimap, int nb_lignes_max, int nb_colonnes_max, int *nb_lignes, int *nb_colonnes);
+
+/**
+ * @brief Resume le carburant d'un bloc, en temps constant.
+ * @name minimap_intensite
+ * @param minimap la pyramide
+ * @param niveau le niveau du bloc
+ * @param ligne la ligne du bloc dans son niveau
+ * @param colonne la colonne du bloc dans son niveau
+ * @param mesure le resume voulu
+ * @return le resume, entre 0 et STATION_MAX_CARBURANT ; 0 seulement si le bloc n'a aucun carburant
+ */
+int minimap_intensite(const t_minimap *minimap, int niveau, int ligne, int colonne, t_minimap_mesure mesure);
+
+#endif // CODE_MINIMAP_H
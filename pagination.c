@@ -0,0 +1,486 @@
+#define _POSIX_C_SOURCE 200809L // Pour pread
+#include "pagination.h"
+#include "tas.h"  // Pour la file de priorite de la recherche
+#include "util.h" // Pour ABS
+#include <fcntl.h>
+#include <limits.h>
+#include <stdlib.h>
+#include <string.h>
+#include <unistd.h>
+
+// ****************************
+// Definitions des types prives
+// ****************************
+// Type pour l'etat de la recherche sur une page, alloue a la premiere visite de la page
+typedef struct
+{
+  int couts[PAGINATION_TAILLE_PAGE];           // Le meilleur cout connu de chaque case, INT_MAX si aucun
+  uint64_t fermees[PAGINATION_TAILLE_PAGE / 64]; // Les cases dont le cout est definitif, un bit par case
+} t_page_recherche;
+
+struct s_pagination
+{
+  t_terrain geometrie;               // La geometrie du terrain, sans ses cases
+  int descripteur;                   // Le fichier du terrain
+  int nb_pages;                      // Le nombre de pages du terrain
+  size_t budget;                     // La memoire accordee aux pages du terrain et a l'etat de la recherche
+  int nb_cadres;                     // Le nombre de pages que le budget permet de garder en memoire hors recherche
+  int nb_cadres_actifs;              // Le nombre de cadres alloues, les autres ayant cede leur place a l'etat de la recherche
+  uint8_t **cadres;                  // Les pages en memoire, PAGINATION_TAILLE_PAGE cases par cadre, NULL pour un cadre cede
+  int *cadre_de_page;                // Pour chaque page, son cadre, -1 si elle n'est pas en memoire
+  int *page_du_cadre;                // Pour chaque cadre, la page qu'il contient, -1 s'il est libre
+  int *plus_recent;                  // Pour chaque cadre, le cadre utilise juste apres lui, -1 si aucun
+  int *plus_ancien;                  // Pour chaque cadre, le cadre utilise juste avant lui, -1 si aucun
+  int tete;                          // Le cadre utilise le plus recemment, -1 si aucun
+  int queue;                         // Le cadre utilise le moins recemment, le prochain a etre reutilise
+  t_pagination_compteurs compteurs;  // Les compteurs d'acces au cache
+  bool erreur;                       // Indique qu'une lecture a echoue depuis le debut de la recherche en cours
+  t_page_recherche **recherche;      // Pour chaque page, l'etat de la recherche en cours, NULL si elle ne l'a pas atteinte
+  int *pages_atteintes;              // Les pages dont l'etat de recherche est alloue
+  int nb_pages_atteintes;            // Le nombre de pages atteintes par la recherche en cours
+};
+
+// **********************************
+// Declarations des fonctions privees
+// **********************************
+/**
+ * @brief Donne le cadre qui contient une page, en la lisant dans le fichier si besoin, a la place
+ * de la page la moins recemment utilisee quand tous les cadres sont occupes. Le cadre devient le
+ * plus recemment utilise.
+ * @name cadre_de_page
+ * @param pagination le terrain pagine
+ * @param page la page voulue
+ * @return le cadre de la page, -1 si la lecture a echoue ou si la page contient une case au carburant invalide
+ */
+int cadre_de_page(t_pagination *pagination, int page);
+
+/**
+ * @brief Retire un cadre de la liste des cadres ranges du plus au moins recemment utilise.
+ * @name detacher_cadre
+ * @param pagination le terrain pagine
+ * @param cadre le cadre a retirer
+ */
+void detacher_cadre(t_pagination *pagination, int cadre);
+
+/**
+ * @brief Place un cadre dans la liste, en tete comme le plus recemment utilise, ou en queue pour
+ * qu'il soit le prochain reutilise.
+ * @name attacher_cadre
+ * @param pagination le terrain pagine
+ * @param cadre le cadre a placer
+ * @param en_tete true pour le placer en tete, false pour le placer en queue
+ */
+void attacher_cadre(t_pagination *pagination, int cadre, bool en_tete);
+
+/**
+ * @brief Donne l'etat de recherche de la page d'une case, en l'allouant a la premiere visite de la page.
+ * L'etat est pris sur le budget : si le budget est epuise, les cadres les moins recemment utilises sont
+ * liberes pour lui faire de la place, jusqu'a ne garder qu'un cadre.
+ * @name page_recherche
+ * @param pagination le terrain pagine
+ * @param indice l'indice de la case
+ * @return l'etat de recherche de la page, NULL si le budget ou la memoire manque
+ */
+t_page_recherche *page_recherche(t_pagination *pagination, int indice);
+
+/**
+ * @brief Libere l'etat de recherche de toutes les pages atteintes par la recherche, et realloue les
+ * cadres qui lui avaient cede leur place.
+ * @name oublier_recherche
+ * @param pagination le terrain pagine
+ */
+void oublier_recherche(t_pagination *pagination);
+
+/**
+ * @brief Libere le cadre le moins recemment utilise, en chassant sa page, pour rendre sa place au budget.
+ * @name ceder_cadre
+ * @param pagination le terrain pagine, avec au moins deux cadres alloues
+ */
+void ceder_cadre(t_pagination *pagination);
+
+/**
+ * @brief Minore le cout restant d'une case a la destination par la distance de Manhattan
+ * (chaque deplacement coute au moins 1).
+ * @name distance_restante
+ * @param geometrie la geometrie du terrain
+ * @param indice l'indice de la case
+ * @param destination_ligne la ligne de la destination
+ * @param destination_colonne la colonne de la destination
+ * @return la distance de Manhattan de la case a la destination
+ */
+int distance_restante(const t_terrain *geometrie, int indice, int destination_ligne, int destination_colonne);
+
+// ***********************************
+// Definitions des fonctions publiques
+// ***********************************
+t_pagination *pagination_ouvrir(const char *chemin, size_t budget_octets, int *depart_ligne, int *depart_colonne, int *sortie_ligne, int *sortie_colonne)
+{
+  if (budget_octets < PAGINATION_TAILLE_PAGE)
+  {
+    return NULL;
+  }
+  t_pagination *pagination = calloc(1, sizeof(t_pagination));
+  if (pagination == NULL)
+  {
+    return NULL;
+  }
+  uint32_t somme;
+  pagination->descripteur = open(chemin, O_RDONLY);
+  if (pagination->descripteur < 0 ||
+      !terrain_lire_entete(pagination->descripteur, &pagination->geometrie, depart_ligne, depart_colonne, sortie_ligne, sortie_colonne, &somme))
+  {
+    pagination_fermer(pagination);
+    return NULL;
+  }
+
+  // Inutile de prevoir plus de cadres que de pages
+  pagination->nb_pages = (pagination->geometrie.nb_cases + PAGINATION_TAILLE_PAGE - 1) / PAGINATION_TAILLE_PAGE;
+  size_t nb_cadres = budget_octets / PAGINATION_TAILLE_PAGE;
+  pagination->budget = budget_octets;
+  pagination->nb_cadres = nb_cadres < (size_t)pagination->nb_pages ? (int)nb_cadres : pagination->nb_pages;
+  pagination->cadres = calloc((size_t)pagination->nb_cadres, sizeof(uint8_t *));
+  pagination->cadre_de_page = malloc((size_t)pagination->nb_pages * sizeof(int));
+  pagination->page_du_cadre = malloc((size_t)pagination->nb_cadres * sizeof(int));
+  pagination->plus_recent = malloc((size_t)pagination->nb_cadres * sizeof(int));
+  pagination->plus_ancien = malloc((size_t)pagination->nb_cadres * sizeof(int));
+  pagination->recherche = calloc((size_t)pagination->nb_pages, sizeof(t_page_recherche *));
+  pagination->pages_atteintes = malloc((size_t)pagination->nb_pages * sizeof(int));
+  if (pagination->cadres == NULL || pagination->cadre_de_page == NULL || pagination->page_du_cadre == NULL ||
+      pagination->plus_recent == NULL || pagination->plus_ancien == NULL || pagination->recherche == NULL ||
+      pagination->pages_atteintes == NULL)
+  {
+    pagination_fermer(pagination);
+    return NULL;
+  }
+
+  for (int page = 0; page < pagination->nb_pages; page++)
+  {
+    pagination->cadre_de_page[page] = -1;
+  }
+  // Les cadres libres sont dans la liste comme les autres, et sont reutilises avant eux
+  pagination->tete = -1;
+  pagination->queue = -1;
+  for (int cadre = 0; cadre < pagination->nb_cadres; cadre++)
+  {
+    pagination->page_du_cadre[cadre] = -1;
+    pagination->cadres[cadre] = malloc(PAGINATION_TAILLE_PAGE);
+    if (pagination->cadres[cadre] == NULL)
+    {
+      pagination_fermer(pagination);
+      return NULL;
+    }
+    attacher_cadre(pagination, cadre, true);
+    pagination->nb_cadres_actifs++;
+  }
+  return pagination;
+}
+
+void pagination_fermer(t_pagination *pagination)
+{
+  if (pagination == NULL)
+  {
+    return;
+  }
+  if (pagination->descripteur >= 0)
+  {
+    close(pagination->descripteur);
+  }
+  for (int cadre = 0; pagination->cadres != NULL && cadre < pagination->nb_cadres; cadre++)
+  {
+    free(pagination->cadres[cadre]);
+  }
+  free(pagination->cadres);
+  free(pagination->cadre_de_page);
+  free(pagination->page_du_cadre);
+  free(pagination->plus_recent);
+  free(pagination->plus_ancien);
+  free(pagination->recherche);
+  free(pagination->pages_atteintes);
+  free(pagination);
+}
+
+const t_terrain *pagination_geometrie(const t_pagination *pagination)
+{
+  return &pagination->geometrie;
+}
+
+uint8_t pagination_get_carburant(t_pagination *pagination, int indice)
+{
+  // Une bordure abimee dans le fichier ne doit pas faire sortir la recherche du terrain
+  if (indice < 0 || indice >= pagination->geometrie.nb_cases)
+  {
+    return TERRAIN_BORDURE;
+  }
+  int cadre = cadre_de_page(pagination, indice / PAGINATION_TAILLE_PAGE);
+  if (cadre < 0)
+  {
+    return TERRAIN_BORDURE;
+  }
+  return pagination->cadres[cadre][indice % PAGINATION_TAILLE_PAGE];
+}
+
+t_pagination_compteurs pagination_get_compteurs(const t_pagination *pagination)
+{
+  return pagination->compteurs;
+}
+
+int pagination_calculer_cout(t_pagination *pagination, int depart_ligne, int depart_colonne, int destination_ligne, int destination_colonne, int *nb_expansions)
+{
+  const t_terrain *geometrie = &pagination->geometrie;
+  int cout = -1;
+  int nb = -1;
+  t_tas tas;
+
+  if (terrain_contient(geometrie, depart_ligne, depart_colonne) && terrain_contient(geometrie, destination_ligne, destination_colonne) &&
+      tas_init(&tas, PAGINATION_TAILLE_PAGE))
+  {
+    pagination->erreur = false;
+    int depart = terrain_indice(geometrie, depart_ligne, depart_colonne);
+    int destination = terrain_indice(geometrie, destination_ligne, destination_colonne);
+    t_page_recherche *etat = page_recherche(pagination, depart);
+    bool echec = etat == NULL || !tas_inserer(&tas, distance_restante(geometrie, depart, destination_ligne, destination_colonne), depart);
+    if (!echec)
+    {
+      etat->couts[depart % PAGINATION_TAILLE_PAGE] = 0;
+      nb = 0;
+    }
+
+    while (!echec && !tas_est_vide(&tas))
+    {
+      t_tas_element element = tas_extraire_min(&tas);
+      int courante = element.indice;
+      t_page_recherche *page = page_recherche(pagination, courante);
+      int dans_page = courante % PAGINATION_TAILLE_PAGE;
+      uint64_t bit = (uint64_t)1 << (dans_page % 64);
+      if (page->fermees[dans_page / 64] & bit)
+      {
+        continue; // Element perime, la case a deja ete developpee
+      }
+      page->fermees[dans_page / 64] |= bit;
+      nb++;
+      if (courante == destination)
+      {
+        cout = page->couts[dans_page];
+        break;
+      }
+
+      int cout_courante = page->couts[dans_page];
+      for (int direction = 0; direction < 4 && !echec; direction++)
+      {
+        int voisin = TERRAIN_VOISINE(geometrie, courante, direction);
+        uint8_t carburant = pagination_get_carburant(pagination, voisin);
+        if (carburant == TERRAIN_BORDURE)
+        {
+          continue;
+        }
+        t_page_recherche *page_voisin = page_recherche(pagination, voisin);
+        if (page_voisin == NULL)
+        {
+          echec = true;
+          break;
+        }
+        int propose = cout_courante + 1 + (STATION_MAX_CARBURANT - carburant);
+        int *cout_voisin = &page_voisin->couts[voisin % PAGINATION_TAILLE_PAGE];
+        if (propose < *cout_voisin)
+        {
+          *cout_voisin = propose;
+          echec = !tas_inserer(&tas, propose + distance_restante(geometrie, voisin, destination_ligne, destination_colonne), voisin);
+        }
+      }
+    }
+
+    // Une page illisible a ete vue comme un mur : le cout trouve n'est pas fiable
+    if (echec || pagination->erreur)
+    {
+      cout = -1;
+      nb = -1;
+    }
+    tas_liberer(&tas);
+    oublier_recherche(pagination);
+  }
+
+  if (nb_expansions != NULL)
+  {
+    *nb_expansions = nb;
+  }
+  return cout;
+}
+
+// *********************************
+// Definitions des fonctions privees
+// *********************************
+int cadre_de_page(t_pagination *pagination, int page)
+{
+  int cadre = pagination->cadre_de_page[page];
+  if (cadre >= 0)
+  {
+    pagination->compteurs.succes++;
+    if (cadre != pagination->tete)
+    {
+      detacher_cadre(pagination, cadre);
+      attacher_cadre(pagination, cadre, true);
+    }
+    return cadre;
+  }
+
+  pagination->compteurs.defauts++;
+  cadre = pagination->queue;
+  detacher_cadre(pagination, cadre);
+  if (pagination->page_du_cadre[cadre] >= 0)
+  {
+    pagination->cadre_de_page[pagination->page_du_cadre[cadre]] = -1;
+    pagination->page_du_cadre[cadre] = -1;
+    pagination->compteurs.evictions++;
+  }
+
+  // La derniere page peut etre incomplete : sa fin est remplie comme la bordure
+  uint8_t *cases = pagination->cadres[cadre];
+  off_t position = (off_t)TERRAIN_TAILLE_ENTETE + (off_t)page * PAGINATION_TAILLE_PAGE;
+  int nb_cases = pagination->geometrie.nb_cases - page * PAGINATION_TAILLE_PAGE;
+  nb_cases = nb_cases < PAGINATION_TAILLE_PAGE ? nb_cases : PAGINATION_TAILLE_PAGE;
+  ssize_t lus = pread(pagination->descripteur, cases, (size_t)nb_cases, position);
+  bool valide = lus == (ssize_t)nb_cases;
+  for (int i = 0; valide && i < nb_cases; i++)
+  {
+    // Au-dela de STATION_MAX_CARBURANT, le cout pour entrer dans la case serait negatif
+    valide = cases[i] <= STATION_MAX_CARBURANT || cases[i] == TERRAIN_BORDURE;
+  }
+  if (!valide)
+  {
+    pagination->erreur = true;
+    attacher_cadre(pagination, cadre, false);
+    return -1;
+  }
+  memset(cases + nb_cases, TERRAIN_BORDURE, (size_t)(PAGINATION_TAILLE_PAGE - nb_cases));
+
+  pagination->cadre_de_page[page] = cadre;
+  pagination->page_du_cadre[cadre] = page;
+  attacher_cadre(pagination, cadre, true);
+  return cadre;
+}
+
+void detacher_cadre(t_pagination *pagination, int cadre)
+{
+  int recent = pagination->plus_recent[cadre];
+  int ancien = pagination->plus_ancien[cadre];
+  if (recent >= 0)
+  {
+    pagination->plus_ancien[recent] = ancien;
+  }
+  else
+  {
+    pagination->tete = ancien;
+  }
+  if (ancien >= 0)
+  {
+    pagination->plus_recent[ancien] = recent;
+  }
+  else
+  {
+    pagination->queue = recent;
+  }
+}
+
+void attacher_cadre(t_pagination *pagination, int cadre, bool en_tete)
+{
+  if (pagination->tete < 0)
+  {
+    pagination->plus_recent[cadre] = -1;
+    pagination->plus_ancien[cadre] = -1;
+    pagination->tete = cadre;
+    pagination->queue = cadre;
+  }
+  else if (en_tete)
+  {
+    pagination->plus_recent[cadre] = -1;
+    pagination->plus_ancien[cadre] = pagination->tete;
+    pagination->plus_recent[pagination->tete] = cadre;
+    pagination->tete = cadre;
+  }
+  else
+  {
+    pagination->plus_recent[cadre] = pagination->queue;
+    pagination->plus_ancien[cadre] = -1;
+    pagination->plus_ancien[pagination->queue] = cadre;
+    pagination->queue = cadre;
+  }
+}
+
+t_page_recherche *page_recherche(t_pagination *pagination, int indice)
+{
+  int page = indice / PAGINATION_TAILLE_PAGE;
+  t_page_recherche *etat = pagination->recherche[page];
+  if (etat == NULL)
+  {
+    // L'etat deja alloue et les cadres encore alloues doivent tenir ensemble dans le budget
+    size_t octets_recherche = (size_t)(pagination->nb_pages_atteintes + 1) * sizeof(t_page_recherche);
+    while (pagination->nb_cadres_actifs > 1 &&
+           (size_t)pagination->nb_cadres_actifs * PAGINATION_TAILLE_PAGE + octets_recherche > pagination->budget)
+    {
+      ceder_cadre(pagination);
+    }
+    if ((size_t)pagination->nb_cadres_actifs * PAGINATION_TAILLE_PAGE + octets_recherche > pagination->budget)
+    {
+      return NULL;
+    }
+    etat = malloc(sizeof(t_page_recherche));
+    if (etat == NULL)
+    {
+      return NULL;
+    }
+    for (int i = 0; i < PAGINATION_TAILLE_PAGE; i++)
+    {
+      etat->couts[i] = INT_MAX;
+    }
+    memset(etat->fermees, 0, sizeof(etat->fermees));
+    pagination->recherche[page] = etat;
+    pagination->pages_atteintes[pagination->nb_pages_atteintes++] = page;
+  }
+  return etat;
+}
+
+void oublier_recherche(t_pagination *pagination)
+{
+  for (int i = 0; i < pagination->nb_pages_atteintes; i++)
+  {
+    int page = pagination->pages_atteintes[i];
+    free(pagination->recherche[page]);
+    pagination->recherche[page] = NULL;
+  }
+  pagination->nb_pages_atteintes = 0;
+
+  // Les cadres cedes reviennent vides, pour etre reutilises avant les autres
+  for (int cadre = 0; cadre < pagination->nb_cadres && pagination->nb_cadres_actifs < pagination->nb_cadres; cadre++)
+  {
+    if (pagination->cadres[cadre] == NULL)
+    {
+      pagination->cadres[cadre] = malloc(PAGINATION_TAILLE_PAGE);
+      if (pagination->cadres[cadre] == NULL)
+      {
+        break; // Le cadre reste cede : le cache sera plus petit, mais toujours juste
+      }
+      attacher_cadre(pagination, cadre, false);
+      pagination->nb_cadres_actifs++;
+    }
+  }
+}
+
+void ceder_cadre(t_pagination *pagination)
+{
+  int cadre = pagination->queue;
+  detacher_cadre(pagination, cadre);
+  if (pagination->page_du_cadre[cadre] >= 0)
+  {
+    pagination->cadre_de_page[pagination->page_du_cadre[cadre]] = -1;
+    pagination->page_du_cadre[cadre] = -1;
+    pagination->compteurs.evictions++;
+  }
+  free(pagination->cadres[cadre]);
+  pagination->cadres[cadre] = NULL;
+  pagination->nb_cadres_actifs--;
+}
+
+int distance_restante(const t_terrain *geometrie, int indice, int destination_ligne, int destination_colonne)
+{
+  return ABS(terrain_ligne(geometrie, indice) - destination_ligne) + ABS(terrain_colonne(geometrie, indice) - destination_colonne);
+}
@@ -0,0 +1,105 @@
+#ifndef CODE_PAGINATION_H
+#define CODE_PAGINATION_H
+
+#include <stdbool.h> // Pour le type bool
+#include <stddef.h>  // Pour le type size_t
+#include <stdint.h>  // Pour le type uint8_t
+#include "terrain.h" // Pour le type t_terrain
+
+// Nombre de cases d'une page, lue d'un bloc dans le fichier (64 tuiles dans la disposition en tuiles)
+#define PAGINATION_TAILLE_PAGE 4096
+
+// *****************************
+// Definitions des types publics
+// *****************************
+
+/**
+ * @brief Terrain lu par pages depuis un fichier ecrit par terrain_enregistrer, pour les cartes qui
+ * ne tiennent pas en memoire. Seules les pages les plus recemment utilisees sont gardees, dans la
+ * limite d'un budget memoire ; les autres sont relues a la demande. Le budget couvre aussi l'etat
+ * d'une recherche en cours, environ 4 octets par case des pages qu'elle atteint, soit plus de quatre
+ * fois une page de terrain : il lui cede des pages en memoire, jusqu'a n'en garder qu'une, et les
+ * recupere a la fin de la recherche. Un t_pagination n'est pas partageable entre fils d'execution.
+ */
+typedef struct s_pagination t_pagination;
+
+/**
+ * @brief Compteurs d'acces au cache de pages, cumules depuis l'ouverture.
+ */
+typedef struct
+{
+  long long succes;     // Le nombre d'acces a une page deja en memoire
+  long long defauts;    // Le nombre d'acces qui ont du lire la page dans le fichier
+  long long evictions;  // Le nombre de pages chassees du cache pour faire de la place
+} t_pagination_compteurs;
+
+// ************************************
+// Declarations des fonctions publiques
+// ************************************
+
+/**
+ * @brief Ouvre un fichier de terrain pour le lire par pages. Seul l'en-tete est lu a l'ouverture.
+ * @name pagination_ouvrir
+ * @param chemin le chemin du fichier
+ * @param budget_octets la memoire accordee aux pages du terrain (au moins PAGINATION_TAILLE_PAGE)
+ * @param depart_ligne l'adresse ou deposer la ligne de depart du joueur
+ * @param depart_colonne l'adresse ou deposer la colonne de depart du joueur
+ * @param sortie_ligne l'adresse ou deposer la ligne de la sortie
+ * @param sortie_colonne l'adresse ou deposer la colonne de la sortie
+ * @return le terrain pagine, NULL si le fichier est illisible ou invalide, si le budget est trop
+ * petit ou si la memoire manque
+ */
+t_pagination *pagination_ouvrir(const char *chemin, size_t budget_octets, int *depart_ligne, int *depart_colonne, int *sortie_ligne, int *sortie_colonne);
+
+/**
+ * @brief Ferme le fichier et libere le cache de pages.
+ * @name pagination_fermer
+ * @param pagination le terrain pagine (peut etre NULL)
+ */
+void pagination_fermer(t_pagination *pagination);
+
+/**
+ * @brief Donne la geometrie du terrain pagine (dimensions, disposition, indices), sans ses cases :
+ * le champ cases est NULL et ne doit pas etre lu.
+ * @name pagination_geometrie
+ * @param pagination le terrain pagine
+ * @return la geometrie du terrain
+ */
+const t_terrain *pagination_geometrie(const t_pagination *pagination);
+
+/**
+ * @brief Donne le carburant d'une case, en lisant sa page dans le fichier si elle n'est pas en memoire.
+ * @name pagination_get_carburant
+ * @param pagination le terrain pagine
+ * @param indice l'indice de la case (voir terrain_indice sur la geometrie)
+ * @return le carburant de la case, TERRAIN_BORDURE pour la bordure, hors du terrain, si la lecture echoue
+ * ou si la page de la case contient une case au-dela de STATION_MAX_CARBURANT
+ */
+uint8_t pagination_get_carburant(t_pagination *pagination, int indice);
+
+/**
+ * @brief Donne les compteurs d'acces au cache de pages.
+ * @name pagination_get_compteurs
+ * @param pagination le terrain pagine
+ * @return les compteurs cumules depuis l'ouverture
+ */
+t_pagination_compteurs pagination_get_compteurs(const t_pagination *pagination);
+
+/**
+ * @brief Calcule le cout du plus court chemin entre deux cases par l'algorithme A*.
+ * Seules les pages atteintes par la frontiere de recherche sont lues, et l'etat de la recherche
+ * n'est alloue que pour elles, le temps de l'appel, sur le budget (voir t_pagination).
+ * @name pagination_calculer_cout
+ * @param pagination le terrain pagine
+ * @param depart_ligne la ligne de la case de depart
+ * @param depart_colonne la colonne de la case de depart
+ * @param destination_ligne la ligne de la case a atteindre
+ * @param destination_colonne la colonne de la case a atteindre
+ * @param nb_expansions l'adresse ou deposer le nombre de cases developpees par la recherche (peut etre NULL)
+ * @return le cout du plus court chemin, -1 si la destination est inaccessible, si une lecture a echoue
+ * ou trouve une case au-dela de STATION_MAX_CARBURANT, si l'etat de la recherche depasse le budget
+ * diminue d'une page, ou si la memoire manque
+ */
+int pagination_calculer_cout(t_pagination *pagination, int depart_ligne, int depart_colonne, int destination_ligne, int destination_colonne, int *nb_expansions);
+
+#endif // CODE_PAGINATION_H
@@ -0,0 +1,504 @@
+#include "planificateur.h"
+#include "dijkstra.h" // Pour NB_CASES_BONUS et l'affichage des directions suggerees
+#include "tas.h"      // Pour la file de priorite en tas
+#include "util.h"     // Pour utiliser MIN et ABS
+#include <limits.h>
+#include <stdbool.h>
+#include <stdint.h>
+#include <stdio.h>
+#include <stdlib.h>
+
+// ****************************
+// Definitions des types prives
+// ****************************
+// Valeur d'un cout inconnu ou d'une sortie inaccessible
+#define PLANIFICATEUR_INFINI INT_MAX
+
+// Nombre de bits d'un mot du tableau des cases en file
+#define BITS_PAR_MOT 64
+
+// Etat du planificateur. La recherche part de la sortie : g et rhs estiment pour chaque case le cout
+// du plus court chemin de cette case a la sortie. Une case est coherente quand g == rhs ; seules les
+// cases incoherentes sont dans la file, rangees selon la cle [min(g, rhs) + h + km ; min(g, rhs)]
+// ou h est la distance Manhattan jusqu'au joueur et km le cumul des deplacements du joueur.
+struct s_planificateur
+{
+  const t_terrain *terrain; // Le terrain de la partie
+  int depart;               // L'indice de la case du joueur
+  int dernier_depart;       // L'indice de la case du joueur lors de la derniere correction de km
+  int destination;          // L'indice de la sortie
+  int km;                   // La correction des cles, qui evite de reclasser la file quand le joueur avance
+  int *g;                   // Le cout connu de chaque case jusqu'a la sortie
+  int *rhs;                 // Le cout de chaque case deduit de ses voisines
+  int *cles;                // La cle principale de chaque case en file
+  int *sous_cles;           // La cle secondaire de chaque case en file
+  uint64_t *en_file;        // Indique si une case est en file, 1 bit par case
+  t_tas file;               // La file des cases incoherentes, a suppression paresseuse
+  bool complet;             // Indique si toutes les cases sont tenues coherentes, et pas seulement le chemin du joueur
+  bool invalide;            // Indique qu'une case incoherente n'a pas pu entrer en file faute de memoire : les couts sont faux
+};
+
+// **********************************
+// Declarations des fonctions privees
+// **********************************
+/**
+ * @brief Additionne deux couts en restant a PLANIFICATEUR_INFINI si l'un d'eux est infini.
+ * @name additionner_couts
+ * @param a le premier cout
+ * @param b le second cout
+ * @return la somme des deux couts
+ */
+int additionner_couts(int a, int b);
+
+/**
+ * @brief Calcule la distance Manhattan entre deux cases.
+ * @name distance_manhattan
+ * @param planificateur le planificateur qui connait le pas du terrain
+ * @param a l'indice lineaire de la premiere case
+ * @param b l'indice lineaire de la seconde case
+ * @return la distance Manhattan entre les deux cases
+ */
+int distance_manhattan(const t_planificateur *planificateur, int a, int b);
+
+/**
+ * @brief Calcule le cout en carburant pour entrer dans une case.
+ * @name cout_entree
+ * @param planificateur le planificateur
+ * @param indice l'indice lineaire de la case
+ * @return le cout pour entrer dans la case
+ */
+int cout_entree(const t_planificateur *planificateur, int indice);
+
+/**
+ * @brief Calcule l'indice de la voisine d'une case dans une direction.
+ * @name voisine
+ * @param planificateur le planificateur
+ * @param indice l'indice lineaire de la case
+ * @param direction la direction de la voisine
+ * @param voisine_indice l'adresse ou deposer l'indice lineaire de la voisine
+ * @return true si la voisine est sur le terrain, false sinon
+ */
+bool voisine(const t_planificateur *planificateur, int indice, t_direction direction, int *voisine_indice);
+
+/**
+ * @brief Calcule la cle de classement d'une case.
+ * @name calculer_cle
+ * @param planificateur le planificateur
+ * @param indice l'indice lineaire de la case
+ * @param cle l'adresse ou deposer la cle principale
+ * @param sous_cle l'adresse ou deposer la cle secondaire
+ */
+void calculer_cle(const t_planificateur *planificateur, int indice, int *cle, int *sous_cle);
+
+/**
+ * @brief Compare deux cles dans l'ordre lexicographique.
+ * @name cle_inferieure
+ * @return true si la cle (cle_a, sous_cle_a) est strictement inferieure a (cle_b, sous_cle_b)
+ */
+bool cle_inferieure(int cle_a, int sous_cle_a, int cle_b, int sous_cle_b);
+
+/**
+ * @brief Recalcule le rhs d'une case a partir de ses voisines et la (re)met en file si elle est incoherente.
+ * Si la file ne peut pas grandir, la case n'est pas marquee en file et le planificateur devient invalide.
+ * @name maj_case
+ * @param planificateur le planificateur
+ * @param indice l'indice lineaire de la case
+ * @return true si la case est a jour, false si la memoire manque
+ */
+bool maj_case(t_planificateur *planificateur, int indice);
+
+/**
+ * @brief Met a jour toutes les voisines d'une case sur le terrain.
+ * @name maj_voisines
+ * @param planificateur le planificateur
+ * @param indice l'indice lineaire de la case
+ * @return true si toutes les voisines sont a jour, false si la memoire manque
+ */
+bool maj_voisines(t_planificateur *planificateur, int indice);
+
+/**
+ * @brief Ecarte les elements perimes du haut de la file.
+ * @name nettoyer_file
+ * @param planificateur le planificateur
+ * @return true s'il reste un element valide dans la file, false sinon
+ */
+bool nettoyer_file(t_planificateur *planificateur);
+
+/**
+ * @brief Developpe les cases incoherentes jusqu'a ce que le cout de la case du joueur soit exact,
+ * ou jusqu'a ce que la file soit vide si le planificateur est complet.
+ * @name calculer_plus_court_chemin
+ * @param planificateur le planificateur
+ * @return true si les couts sont exacts, false si le planificateur est invalide faute de memoire
+ */
+bool calculer_plus_court_chemin(t_planificateur *planificateur);
+
+/**
+ * @brief Donne le pas suivant du plus court chemin depuis une case, en descendant les couts : la
+ * meilleure voisine est toujours sur un plus court chemin.
+ * @name descendre_champ
+ * @param planificateur le planificateur, a jour du chemin qui passe par la case
+ * @param indice l'indice lineaire de la case
+ * @param direction l'adresse ou deposer la direction de la voisine choisie
+ * @return l'indice lineaire de la voisine choisie, -1 si aucune voisine ne mene a la sortie
+ */
+int descendre_champ(const t_planificateur *planificateur, int indice, t_direction *direction);
+
+// ***********************************
+// Definitions des fonctions publiques
+// ***********************************
+t_planificateur *planificateur_creer(const t_terrain *terrain, int depart_ligne, int depart_colonne, int destination_ligne, int destination_colonne)
+{
+  size_t nb_cases = (size_t)terrain->nb_cases;
+  size_t nb_mots = (nb_cases + BITS_PAR_MOT - 1) / BITS_PAR_MOT;
+
+  t_planificateur *planificateur = malloc(sizeof(t_planificateur));
+  if (planificateur == NULL)
+  {
+    return NULL;
+  }
+  planificateur->g = malloc(nb_cases * sizeof(int));
+  planificateur->rhs = malloc(nb_cases * sizeof(int));
+  planificateur->cles = malloc(nb_cases * sizeof(int));
+  planificateur->sous_cles = malloc(nb_cases * sizeof(int));
+  planificateur->en_file = calloc(nb_mots, sizeof(uint64_t));
+  if (planificateur->g == NULL || planificateur->rhs == NULL || planificateur->cles == NULL ||
+      planificateur->sous_cles == NULL || planificateur->en_file == NULL ||
+      !tas_init(&planificateur->file, (int)nb_cases))
+  {
+    free(planificateur->g);
+    free(planificateur->rhs);
+    free(planificateur->cles);
+    free(planificateur->sous_cles);
+    free(planificateur->en_file);
+    free(planificateur);
+    return NULL;
+  }
+
+  planificateur->terrain = terrain;
+  planificateur->depart = terrain_indice(terrain, depart_ligne, depart_colonne);
+  planificateur->dernier_depart = planificateur->depart;
+  planificateur->destination = terrain_indice(terrain, destination_ligne, destination_colonne);
+  planificateur->km = 0;
+  planificateur->complet = false;
+  planificateur->invalide = false;
+  for (size_t i = 0; i < nb_cases; i++)
+  {
+    planificateur->g[i] = PLANIFICATEUR_INFINI;
+    planificateur->rhs[i] = PLANIFICATEUR_INFINI;
+  }
+
+  // Seule la sortie est incoherente au depart : son cout jusqu'a elle-meme est nul
+  planificateur->rhs[planificateur->destination] = 0;
+  if (!maj_case(planificateur, planificateur->destination))
+  {
+    planificateur_detruire(planificateur);
+    return NULL;
+  }
+  return planificateur;
+}
+
+void planificateur_detruire(t_planificateur *planificateur)
+{
+  if (planificateur == NULL)
+  {
+    return;
+  }
+  tas_liberer(&planificateur->file);
+  free(planificateur->g);
+  free(planificateur->rhs);
+  free(planificateur->cles);
+  free(planificateur->sous_cles);
+  free(planificateur->en_file);
+  free(planificateur);
+}
+
+bool planificateur_completer(t_planificateur *planificateur)
+{
+  planificateur->complet = true;
+  return calculer_plus_court_chemin(planificateur);
+}
+
+int planificateur_get_distance(const t_planificateur *planificateur, int ligne, int colonne)
+{
+  int distance = planificateur->g[terrain_indice(planificateur->terrain, ligne, colonne)];
+  return distance == PLANIFICATEUR_INFINI || planificateur->invalide ? -1 : distance;
+}
+
+void planificateur_deplacer_depart(t_planificateur *planificateur, int depart_ligne, int depart_colonne)
+{
+  planificateur->depart = terrain_indice(planificateur->terrain, depart_ligne, depart_colonne);
+
+  // Les cles en file ont ete calculees pour l'ancienne position : h y a baisse d'au plus
+  // la distance parcourue, qu'on ajoute a km pour garder toutes les cles comparables
+  planificateur->km += distance_manhattan(planificateur, planificateur->dernier_depart, planificateur->depart);
+  planificateur->dernier_depart = planificateur->depart;
+}
+
+bool planificateur_signaler_case_modifiee(t_planificateur *planificateur, int ligne, int colonne)
+{
+  // Le cout des arcs qui entrent dans la case a change : seules ses voisines sont a revoir
+  if (!maj_voisines(planificateur, terrain_indice(planificateur->terrain, ligne, colonne)))
+  {
+    return false;
+  }
+
+  // Un champ complet est repare tout de suite, pour que les indications restent une simple lecture
+  return !planificateur->complet || calculer_plus_court_chemin(planificateur);
+}
+
+int planificateur_calculer_chemin(t_planificateur *planificateur, t_direction directions[], int nb_max, int *cout)
+{
+  if (!calculer_plus_court_chemin(planificateur))
+  {
+    if (cout != NULL)
+    {
+      *cout = -1;
+    }
+    return -1;
+  }
+
+  int cout_total = planificateur->g[planificateur->depart];
+  if (cout != NULL)
+  {
+    *cout = cout_total == PLANIFICATEUR_INFINI ? -1 : cout_total;
+  }
+  if (cout_total == PLANIFICATEUR_INFINI)
+  {
+    return 0;
+  }
+
+  int nb_directions = 0;
+  int courante = planificateur->depart;
+  while (courante != planificateur->destination && nb_directions < nb_max)
+  {
+    courante = descendre_champ(planificateur, courante, &directions[nb_directions]);
+    if (courante < 0)
+    {
+      break;
+    }
+    nb_directions++;
+  }
+  return nb_directions;
+}
+
+int planificateur_carburant_arrivee(t_planificateur *planificateur, int carburant)
+{
+  if (!calculer_plus_court_chemin(planificateur) || planificateur->g[planificateur->depart] == PLANIFICATEUR_INFINI)
+  {
+    return -1;
+  }
+
+  // Les couts decroissent strictement le long du chemin : aucune station n'est comptee deux fois
+  const t_terrain *terrain = planificateur->terrain;
+  int courante = planificateur->depart;
+  while (courante != planificateur->destination)
+  {
+    if (carburant <= 0)
+    {
+      return -1;
+    }
+    t_direction direction;
+    courante = descendre_champ(planificateur, courante, &direction);
+    if (courante < 0)
+    {
+      return -1;
+    }
+    carburant += terrain->cases[courante] - COUT_DEPLACEMENT_VOISIN;
+  }
+  return carburant;
+}
+
+void planificateur_acheter_bonus(t_planificateur *planificateur, int *joueur_carburant)
+{
+  if (*joueur_carburant < 10)
+  {
+    printf("Pas assez de carburant pour acheter le bonus.\n");
+    return;
+  }
+
+  t_direction directions[NB_CASES_BONUS];
+  int nb_directions = planificateur_calculer_chemin(planificateur, directions, NB_CASES_BONUS, NULL);
+
+  if (nb_directions > 0)
+  {
+    *joueur_carburant -= 10;
+    dijkstra_afficher_directions_suggerees(directions, nb_directions);
+  }
+  else if (nb_directions < 0)
+  {
+    printf("Memoire insuffisante pour calculer le chemin.\n");
+  }
+  else
+  {
+    printf("Aucun chemin trouve vers la destination.\n");
+  }
+}
+
+// *********************************
+// Definitions des fonctions privees
+// *********************************
+int descendre_champ(const t_planificateur *planificateur, int indice, t_direction *direction)
+{
+  int meilleur_cout = PLANIFICATEUR_INFINI;
+  int meilleure_voisine = -1;
+  for (t_direction d = DIRECTION_DROITE; d <= DIRECTION_GAUCHE; d++)
+  {
+    int v;
+    if (voisine(planificateur, indice, d, &v))
+    {
+      int cout_voisine = additionner_couts(cout_entree(planificateur, v), planificateur->g[v]);
+      if (cout_voisine < meilleur_cout)
+      {
+        meilleur_cout = cout_voisine;
+        meilleure_voisine = v;
+        *direction = d;
+      }
+    }
+  }
+  return meilleure_voisine;
+}
+
+int additionner_couts(int a, int b)
+{
+  if (a == PLANIFICATEUR_INFINI || b == PLANIFICATEUR_INFINI)
+  {
+    return PLANIFICATEUR_INFINI;
+  }
+  return a + b;
+}
+
+int distance_manhattan(const t_planificateur *planificateur, int a, int b)
+{
+  const t_terrain *terrain = planificateur->terrain;
+  return ABS(terrain_ligne(terrain, a) - terrain_ligne(terrain, b)) + ABS(terrain_colonne(terrain, a) - terrain_colonne(terrain, b));
+}
+
+int cout_entree(const t_planificateur *planificateur, int indice)
+{
+  return 1 + (STATION_MAX_CARBURANT - planificateur->terrain->cases[indice]);
+}
+
+bool voisine(const t_planificateur *planificateur, int indice, t_direction direction, int *voisine_indice)
+{
+  *voisine_indice = TERRAIN_VOISINE(planificateur->terrain, indice, direction);
+  return planificateur->terrain->cases[*voisine_indice] != TERRAIN_BORDURE;
+}
+
+void calculer_cle(const t_planificateur *planificateur, int indice, int *cle, int *sous_cle)
+{
+  int m = MIN(planificateur->g[indice], planificateur->rhs[indice]);
+  *sous_cle = m;
+  *cle = additionner_couts(m, distance_manhattan(planificateur, planificateur->depart, indice) + planificateur->km);
+}
+
+bool cle_inferieure(int cle_a, int sous_cle_a, int cle_b, int sous_cle_b)
+{
+  return cle_a < cle_b || (cle_a == cle_b && sous_cle_a < sous_cle_b);
+}
+
+bool maj_case(t_planificateur *planificateur, int indice)
+{
+  if (indice != planificateur->destination)
+  {
+    int meilleur = PLANIFICATEUR_INFINI;
+    for (t_direction direction = DIRECTION_DROITE; direction <= DIRECTION_GAUCHE; direction++)
+    {
+      int v;
+      if (voisine(planificateur, indice, direction, &v))
+      {
+        meilleur = MIN(meilleur, additionner_couts(cout_entree(planificateur, v), planificateur->g[v]));
+      }
+    }
+    planificateur->rhs[indice] = meilleur;
+  }
+
+  // Retirer la case de la file revient a effacer son bit : son element deviendra perime
+  planificateur->en_file[indice / BITS_PAR_MOT] &= ~((uint64_t)1 << (indice % BITS_PAR_MOT));
+  if (planificateur->g[indice] != planificateur->rhs[indice])
+  {
+    calculer_cle(planificateur, indice, &planificateur->cles[indice], &planificateur->sous_cles[indice]);
+    if (!tas_inserer_cle(&planificateur->file, planificateur->cles[indice], planificateur->sous_cles[indice], indice))
+    {
+      // La case reste incoherente hors de la file : plus aucun cout ne peut etre garanti
+      planificateur->invalide = true;
+      return false;
+    }
+    planificateur->en_file[indice / BITS_PAR_MOT] |= (uint64_t)1 << (indice % BITS_PAR_MOT);
+  }
+  return true;
+}
+
+bool maj_voisines(t_planificateur *planificateur, int indice)
+{
+  for (t_direction direction = DIRECTION_DROITE; direction <= DIRECTION_GAUCHE; direction++)
+  {
+    int v;
+    if (voisine(planificateur, indice, direction, &v) && !maj_case(planificateur, v))
+    {
+      return false;
+    }
+  }
+  return true;
+}
+
+bool nettoyer_file(t_planificateur *planificateur)
+{
+  while (!tas_est_vide(&planificateur->file))
+  {
+    t_tas_element haut = tas_consulter_min(&planificateur->file);
+    int i = haut.indice;
+    if ((planificateur->en_file[i / BITS_PAR_MOT] >> (i % BITS_PAR_MOT)) & 1 &&
+        haut.priorite == planificateur->cles[i] && haut.sous_priorite == planificateur->sous_cles[i])
+    {
+      return true;
+    }
+    tas_extraire_min(&planificateur->file);
+  }
+  return false;
+}
+
+bool calculer_plus_court_chemin(t_planificateur *planificateur)
+{
+  // Une case qui n'a pas pu entrer en file rend le planificateur invalide : les voisines suivantes sont inutiles
+  int depart = planificateur->depart;
+  while (!planificateur->invalide && nettoyer_file(planificateur))
+  {
+    t_tas_element haut = tas_consulter_min(&planificateur->file);
+    int cle_depart, sous_cle_depart;
+    calculer_cle(planificateur, depart, &cle_depart, &sous_cle_depart);
+    if (!planificateur->complet && !cle_inferieure(haut.priorite, haut.sous_priorite, cle_depart, sous_cle_depart) &&
+        planificateur->rhs[depart] == planificateur->g[depart])
+    {
+      break;
+    }
+
+    int u = haut.indice;
+    tas_extraire_min(&planificateur->file);
+    planificateur->en_file[u / BITS_PAR_MOT] &= ~((uint64_t)1 << (u % BITS_PAR_MOT));
+
+    int cle, sous_cle;
+    calculer_cle(planificateur, u, &cle, &sous_cle);
+    if (cle_inferieure(haut.priorite, haut.sous_priorite, cle, sous_cle))
+    {
+      // Cle perimee par un deplacement du joueur : reclasser la case
+      maj_case(planificateur, u);
+    }
+    else if (planificateur->g[u] > planificateur->rhs[u])
+    {
+      // Case sur-estimee : son cout devient exact et se propage a ses voisines
+      planificateur->g[u] = planificateur->rhs[u];
+      maj_voisines(planificateur, u);
+    }
+    else
+    {
+      // Case sous-estimee (son cout a augmente) : l'oublier et la reevaluer avec ses voisines
+      planificateur->g[u] = PLANIFICATEUR_INFINI;
+      if (maj_case(planificateur, u))
+      {
+        maj_voisines(planificateur, u);
+      }
+    }
+  }
+  return !planificateur->invalide;
+}
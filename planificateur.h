@@ -0,0 +1,119 @@
+#ifndef CODE_PLANIFICATEUR_H
+#define CODE_PLANIFICATEUR_H
+
+#include <stdbool.h> // Pour le type bool
+#include "jeu.h"     // Pour le type t_direction
+#include "terrain.h" // Pour le type t_terrain
+
+// *****************************
+// Definitions des types publics
+// *****************************
+
+/**
+ * @brief Planificateur incremental (D* Lite) du plus court chemin entre le joueur et la sortie.
+ * La recherche est faite a rebours depuis la sortie et son arbre est conserve d'un calcul a
+ * l'autre : quand le joueur avance ou qu'une case change de carburant, seules les cases dont le
+ * cout est affecte sont reexaminees au calcul suivant. Si la memoire manque pour mettre une case en
+ * file, le planificateur devient invalide : tous ses calculs suivants echouent.
+ */
+typedef struct s_planificateur t_planificateur;
+
+// ************************************
+// Declarations des fonctions publiques
+// ************************************
+
+/**
+ * @brief Alloue un planificateur pour une partie.
+ * @name planificateur_creer
+ * @param terrain le terrain de la partie, qui doit rester alloue tant que le planificateur sert
+ * @param depart_ligne la ligne ou se trouve le joueur
+ * @param depart_colonne la colonne ou se trouve le joueur
+ * @param destination_ligne la ligne de la sortie
+ * @param destination_colonne la colonne de la sortie
+ * @return le planificateur, NULL si la memoire manque
+ */
+t_planificateur *planificateur_creer(const t_terrain *terrain, int depart_ligne, int depart_colonne, int destination_ligne, int destination_colonne);
+
+/**
+ * @brief Libere un planificateur.
+ * @name planificateur_detruire
+ * @param planificateur le planificateur a liberer (peut etre NULL)
+ */
+void planificateur_detruire(t_planificateur *planificateur);
+
+/**
+ * @brief Propage les couts jusqu'a la derniere case accessible : le planificateur tient desormais
+ * un champ complet des distances de chaque case a la sortie. Chaque case modifiee est ensuite
+ * reparee aussitot, et planificateur_calculer_chemin n'a plus qu'a descendre le champ depuis le
+ * joueur, en temps proportionnel a la longueur du chemin.
+ * @name planificateur_completer
+ * @param planificateur le planificateur
+ * @return true si le champ est complet, false si la memoire manque
+ */
+bool planificateur_completer(t_planificateur *planificateur);
+
+/**
+ * @brief Retourne le cout du plus court chemin d'une case a la sortie.
+ * @name planificateur_get_distance
+ * @param planificateur le planificateur, complet ou venant de calculer le chemin depuis cette case
+ * @param ligne la ligne de la case
+ * @param colonne la colonne de la case
+ * @return le cout du plus court chemin de la case a la sortie, -1 s'il n'est pas connu ou si le
+ * planificateur est invalide
+ */
+int planificateur_get_distance(const t_planificateur *planificateur, int ligne, int colonne);
+
+/**
+ * @brief Indique au planificateur que le joueur s'est deplace.
+ * @name planificateur_deplacer_depart
+ * @param planificateur le planificateur
+ * @param depart_ligne la nouvelle ligne du joueur
+ * @param depart_colonne la nouvelle colonne du joueur
+ */
+void planificateur_deplacer_depart(t_planificateur *planificateur, int depart_ligne, int depart_colonne);
+
+/**
+ * @brief Indique au planificateur que le carburant d'une case du terrain a change,
+ * et donc le cout pour y entrer.
+ * @name planificateur_signaler_case_modifiee
+ * @param planificateur le planificateur
+ * @param ligne la ligne de la case modifiee
+ * @param colonne la colonne de la case modifiee
+ * @return true si le planificateur est a jour, false si la memoire manque
+ */
+bool planificateur_signaler_case_modifiee(t_planificateur *planificateur, int ligne, int colonne);
+
+/**
+ * @brief Met a jour le plus court chemin du joueur a la sortie et en donne les premieres directions.
+ * @name planificateur_calculer_chemin
+ * @param planificateur le planificateur
+ * @param directions le tableau ou deposer les premieres directions a suivre
+ * @param nb_max le nombre maximal de directions a deposer
+ * @param cout l'adresse ou deposer le cout total du chemin, -1 si la sortie est inaccessible ou si la
+ * memoire manque (peut etre NULL)
+ * @return le nombre de directions deposees, -1 si la memoire manque
+ */
+int planificateur_calculer_chemin(t_planificateur *planificateur, t_direction directions[], int nb_max, int *cout);
+
+/**
+ * @brief Suit tout le plus court chemin du joueur a la sortie et compte le carburant du joueur en
+ * chemin : chaque deplacement coute COUT_DEPLACEMENT_VOISIN et rapporte le carburant de la case
+ * d'arrivee. Planificateur complet, il ne coute que la longueur du chemin.
+ * @name planificateur_carburant_arrivee
+ * @param planificateur le planificateur, a jour de la position du joueur et du terrain
+ * @param carburant le carburant du joueur au depart
+ * @return le carburant restant a l'arrivee, -1 si la sortie est inaccessible, si le joueur tombe
+ * en panne avant de l'atteindre ou si la memoire manque
+ */
+int planificateur_carburant_arrivee(t_planificateur *planificateur, int carburant);
+
+/**
+ * @brief Achete un bonus au prix de 10L de carburant et affiche les premieres directions
+ * du chemin qui utilise le moins de carburant, calcule de facon incrementale.
+ * @name planificateur_acheter_bonus
+ * @param planificateur le planificateur, a jour de la position du joueur et du terrain
+ * @param joueur_carburant l'adresse de la quantite de carburant du joueur
+ */
+void planificateur_acheter_bonus(t_planificateur *planificateur, int *joueur_carburant);
+
+#endif // CODE_PLANIFICATEUR_H
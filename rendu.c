@@ -0,0 +1,607 @@
+#define _POSIX_C_SOURCE 200809L // Pour write et isatty
+#include "rendu.h"
+#include "couleur.h" // Pour les sequences de couleur
+#include "util.h"    // Pour MIN et MAX
+#include <errno.h>
+#include <stdint.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <sys/ioctl.h>
+#include <unistd.h>
+
+// Nombre de colonnes du terminal occupees par chaque case
+#define RENDU_LARGEUR_CASE 3
+
+// Nombre maximal d'octets d'une case : une sequence de couleur puis son contenu
+#define RENDU_OCTETS_PAR_CASE (COULEUR_TAILLE_MAX + RENDU_LARGEUR_CASE)
+
+// Nombre maximal d'octets d'un caractere de la minicarte : une sequence de couleur puis le caractere
+#define RENDU_OCTETS_PAR_BLOC (COULEUR_TAILLE_MAX + 1)
+
+// Nombre maximal d'octets d'un deplacement du curseur : "\033[" ligne ";" colonne "H"
+#define RENDU_OCTETS_POSITION 24
+
+// Nombre maximal d'octets d'une case ou d'un caractere de la minicarte mis a jour par rendu_actualiser
+#define RENDU_OCTETS_PAR_MISE_A_JOUR (RENDU_OCTETS_POSITION + RENDU_OCTETS_PAR_CASE)
+
+// Place reservee aux commandes qui encadrent une image (effacement, zone de defilement, curseur)
+#define RENDU_OCTETS_COMMANDES 96
+
+// ****************************
+// Definitions des types prives
+// ****************************
+// Type pour les familles de cases, affichees chacune dans sa couleur
+typedef enum
+{
+  RENDU_AUCUNE = -1, // Aucune couleur encore choisie
+  RENDU_JOUEUR,      // La case courante
+  RENDU_SORTIE,      // La case de destination
+  RENDU_VIDE,        // Une case sans carburant
+  RENDU_STATION,     // Une station de carburant
+  RENDU_NB_FAMILLES
+} t_rendu_famille;
+
+// Type pour les zones de l'image, l'une sous l'autre
+typedef enum
+{
+  RENDU_FENETRE, // Les cases autour de la case courante, RENDU_LARGEUR_CASE colonnes chacune
+  RENDU_MINIMAP, // Les blocs de la minicarte, une colonne chacun
+  RENDU_NB_ZONES
+} t_rendu_zone;
+
+// Type pour la disposition d'une image : ce que montre chaque zone et ou
+typedef struct
+{
+  int premiere_ligne[RENDU_NB_ZONES]; // La ligne du terminal ou commence chaque zone, a partir de 1
+  int nb_lignes[RENDU_NB_ZONES];      // Le nombre de lignes de chaque zone, 0 si elle est absente
+  int nb_colonnes[RENDU_NB_ZONES];    // Le nombre de cases ou de blocs par ligne de chaque zone
+  size_t decalage[RENDU_NB_ZONES];    // L'indice de la premiere case de chaque zone dans les cases affichees
+  int hauteur;                        // Le nombre de lignes du terminal occupees par l'image
+  int largeur;                        // Le nombre de colonnes du terminal occupees par l'image
+  int origine_ligne;                  // La ligne du terrain en haut de la fenetre
+  int origine_colonne;                // La colonne du terrain a gauche de la fenetre
+  int niveau;                         // Le niveau de la pyramide lu par la minicarte
+  int courante_ligne;                 // La ligne de la case courante
+  int courante_colonne;               // La colonne de la case courante
+  int destination_ligne;              // La ligne de la case de destination
+  int destination_colonne;            // La colonne de la case de destination
+} t_rendu_scene;
+
+struct s_rendu
+{
+  int nb_lignes;             // Le nombre de lignes de cases de la fenetre
+  int nb_colonnes;           // Le nombre de colonnes de cases de la fenetre
+  const t_minimap *minimap;  // La pyramide lue par la minicarte, NULL sans minicarte
+  int minimap_lignes;        // Le nombre maximal de lignes de la minicarte
+  int minimap_colonnes;      // Le nombre maximal de colonnes de la minicarte
+  t_minimap_mesure mesure;   // Le resume du carburant de chaque bloc de la minicarte
+  char *tampon;              // Le tampon ou est composee l'image
+  size_t capacite;           // La taille du tampon, suffisante pour l'image la plus longue
+  uint16_t *affichees;       // Pour chaque case et chaque bloc, ce qui y est affiche : sa famille de couleur et sa valeur
+  bool ecran_fixe;           // Indique que l'image est affichee en haut du terminal, au-dessus du texte qui defile
+  t_rendu_scene scene_fixee; // La disposition de l'image affichee, quand ecran_fixe
+};
+
+// Le style et les couleurs de chaque famille
+static const int couleurs_familles[RENDU_NB_FAMILLES][3] = {
+    {STYLE_BOLD, FG_BRIGHT_YELLOW, BG_BLACK}, // RENDU_JOUEUR
+    {STYLE_BOLD, FG_BRIGHT_GREEN, BG_BLACK},  // RENDU_SORTIE
+    {STYLE_DIM, FG_WHITE, BG_BLACK},          // RENDU_VIDE
+    {STYLE_RESET, FG_BRIGHT_CYAN, BG_BLACK},  // RENDU_STATION
+};
+
+// Le caractere de la minicarte pour chaque intensite de carburant, du bloc vide au plus riche
+static const char rampe_minimap[STATION_MAX_CARBURANT + 2] = " .:-=+*#%@";
+
+// **********************************
+// Declarations des fonctions privees
+// **********************************
+/**
+ * @brief Donne la famille d'une case, qui decide de sa couleur.
+ * @name famille_case
+ * @param ligne la ligne de la case
+ * @param colonne la colonne de la case
+ * @param carburant le carburant de la case
+ * @param courante_ligne la ligne de la case courante
+ * @param courante_colonne la colonne de la case courante
+ * @param destination_ligne la ligne de la case de destination
+ * @param destination_colonne la colonne de la case de destination
+ * @return la famille de la case
+ */
+t_rendu_famille famille_case(int ligne, int colonne, uint8_t carburant, int courante_ligne, int courante_colonne, int destination_ligne, int destination_colonne);
+
+/**
+ * @brief Dispose une image : la fenetre, centree sur la case courante et ramenee dans le terrain,
+ * puis la minicarte, au niveau le plus fin qui tient dans sa taille.
+ * @name cadrer_scene
+ * @param rendu le moteur d'affichage
+ * @param terrain le terrain
+ * @param courante_ligne la ligne de la case courante
+ * @param courante_colonne la colonne de la case courante
+ * @param destination_ligne la ligne de la case de destination
+ * @param destination_colonne la colonne de la case de destination
+ * @param scene l'adresse ou deposer la disposition
+ */
+void cadrer_scene(const t_rendu *rendu, const t_terrain *terrain, int courante_ligne, int courante_colonne, int destination_ligne, int destination_colonne, t_rendu_scene *scene);
+
+/**
+ * @brief Donne ce qu'affiche une case de la fenetre ou un bloc de la minicarte : sa famille de couleur
+ * dans l'octet haut, son carburant (ou l'intensite du bloc) dans l'octet bas.
+ * @name contenu_case
+ * @param rendu le moteur d'affichage
+ * @param scene la disposition de l'image
+ * @param terrain le terrain
+ * @param zone la zone de la case
+ * @param ligne la ligne de la case dans sa zone
+ * @param colonne la colonne de la case dans sa zone
+ * @return le contenu de la case
+ */
+uint16_t contenu_case(const t_rendu *rendu, const t_rendu_scene *scene, const t_terrain *terrain, t_rendu_zone zone, int ligne, int colonne);
+
+/**
+ * @brief Ecrit une case : la sequence de sa couleur si elle differe de la couleur courante, puis son contenu.
+ * @name ecrire_case
+ * @param fin la fin du tampon, ou ecrire
+ * @param zone la zone de la case
+ * @param contenu le contenu de la case, tel que donne par contenu_case
+ * @param courante l'adresse de la famille dont la couleur est active, mise a jour
+ * @return la nouvelle fin du tampon
+ */
+char *ecrire_case(char *fin, t_rendu_zone zone, uint16_t contenu, t_rendu_famille *courante);
+
+/**
+ * @brief Ecrit le contenu d'une case de carburant sur RENDU_LARGEUR_CASE caracteres, comme printf("%2d ")
+ * le ferait jusqu'a 99, sans passer par printf.
+ * @name ecrire_carburant
+ * @param fin la fin du tampon, ou ecrire
+ * @param carburant le carburant de la case
+ * @return la nouvelle fin du tampon
+ */
+char *ecrire_carburant(char *fin, uint8_t carburant);
+
+/**
+ * @brief Ecrit la sequence qui place le curseur du terminal.
+ * @name ecrire_position
+ * @param fin la fin du tampon, ou ecrire
+ * @param ligne la ligne du terminal, a partir de 1
+ * @param colonne la colonne du terminal, a partir de 1
+ * @return la nouvelle fin du tampon
+ */
+char *ecrire_position(char *fin, int ligne, int colonne);
+
+/**
+ * @brief Ecrit un entier positif en decimal, sans zero de tete.
+ * @name ecrire_entier
+ * @param fin la fin du tampon, ou ecrire
+ * @param valeur l'entier a ecrire
+ * @return la nouvelle fin du tampon
+ */
+char *ecrire_entier(char *fin, int valeur);
+
+/**
+ * @brief Ecrit toutes les lignes de l'image, chacune terminee par le retour aux couleurs par defaut
+ * et un saut de ligne, et retient ce qui est affiche dans chaque case.
+ * @name composer_image
+ * @param rendu le moteur d'affichage
+ * @param scene la disposition de l'image
+ * @param terrain le terrain
+ * @param fin la fin du tampon, ou ecrire
+ * @return la nouvelle fin du tampon
+ */
+char *composer_image(t_rendu *rendu, const t_rendu_scene *scene, const t_terrain *terrain, char *fin);
+
+/**
+ * @brief Indique si l'image peut rester affichee en haut du terminal, au-dessus d'au moins
+ * quelques lignes de texte : il faut un terminal assez grand.
+ * @name terminal_assez_grand
+ * @param scene la disposition de l'image
+ * @param hauteur l'adresse ou deposer le nombre de lignes du terminal
+ * @return true si l'image tient dans le terminal, false sinon ou si la sortie n'est pas un terminal
+ */
+bool terminal_assez_grand(const t_rendu_scene *scene, int *hauteur);
+
+/**
+ * @brief Ecrit tout un tampon sur la sortie standard, en reprenant apres une ecriture partielle ou interrompue.
+ * @name ecrire_tout
+ * @param tampon le tampon a ecrire
+ * @param taille le nombre d'octets a ecrire
+ * @return true si tout a ete ecrit, false sinon
+ */
+bool ecrire_tout(const char *tampon, size_t taille);
+
+// ***********************************
+// Definitions des fonctions publiques
+// ***********************************
+t_rendu *rendu_creer(int nb_lignes, int nb_colonnes)
+{
+  if (nb_lignes <= 0 || nb_colonnes <= 0 ||
+      (size_t)nb_colonnes > (SIZE_MAX / (size_t)nb_lignes - sizeof(COULEUR_RESET) - RENDU_OCTETS_COMMANDES) / RENDU_OCTETS_PAR_CASE)
+  {
+    return NULL;
+  }
+  t_rendu *rendu = malloc(sizeof(t_rendu));
+  if (rendu == NULL)
+  {
+    return NULL;
+  }
+  // Chaque ligne se termine par le retour aux couleurs par defaut et un saut de ligne
+  rendu->nb_lignes = nb_lignes;
+  rendu->nb_colonnes = nb_colonnes;
+  rendu->minimap = NULL;
+  rendu->minimap_lignes = 0;
+  rendu->minimap_colonnes = 0;
+  rendu->mesure = MINIMAP_SOMME;
+  rendu->capacite = (size_t)nb_lignes * ((size_t)nb_colonnes * RENDU_OCTETS_PAR_CASE + sizeof(COULEUR_RESET)) + RENDU_OCTETS_COMMANDES;
+  rendu->tampon = malloc(rendu->capacite);
+  rendu->affichees = malloc((size_t)nb_lignes * (size_t)nb_colonnes * sizeof(uint16_t));
+  rendu->ecran_fixe = false;
+  if (rendu->tampon == NULL || rendu->affichees == NULL)
+  {
+    rendu_detruire(rendu);
+    return NULL;
+  }
+  return rendu;
+}
+
+bool rendu_activer_minimap(t_rendu *rendu, const t_minimap *minimap, int nb_lignes_max, int nb_colonnes_max, t_minimap_mesure mesure)
+{
+  if (nb_lignes_max <= 0 || nb_colonnes_max <= 0)
+  {
+    return false;
+  }
+  // La minicarte est precedee d'une ligne vide, et chacune de ses lignes se termine comme celles de la fenetre
+  size_t fenetre = (size_t)rendu->nb_lignes * (size_t)rendu->nb_colonnes;
+  size_t octets_par_ligne = (size_t)nb_colonnes_max * RENDU_OCTETS_PAR_BLOC + sizeof(COULEUR_RESET);
+  size_t sans_minimap = (size_t)rendu->nb_lignes * ((size_t)rendu->nb_colonnes * RENDU_OCTETS_PAR_CASE + sizeof(COULEUR_RESET)) + RENDU_OCTETS_COMMANDES;
+  if (octets_par_ligne > (SIZE_MAX - sans_minimap - 1) / (size_t)nb_lignes_max ||
+      (size_t)nb_colonnes_max > (SIZE_MAX / sizeof(uint16_t) - fenetre) / (size_t)nb_lignes_max)
+  {
+    return false;
+  }
+  size_t capacite = sans_minimap + 1 + (size_t)nb_lignes_max * octets_par_ligne;
+  char *tampon = realloc(rendu->tampon, capacite);
+  if (tampon == NULL)
+  {
+    return false;
+  }
+  rendu->tampon = tampon;
+  uint16_t *affichees = realloc(rendu->affichees, (fenetre + (size_t)nb_lignes_max * (size_t)nb_colonnes_max) * sizeof(uint16_t));
+  if (affichees == NULL)
+  {
+    return false; // Le tampon agrandi sert aussi bien sans minicarte
+  }
+  rendu->affichees = affichees;
+  rendu->capacite = capacite;
+  rendu->minimap = minimap;
+  rendu->minimap_lignes = nb_lignes_max;
+  rendu->minimap_colonnes = nb_colonnes_max;
+  rendu->mesure = mesure;
+  rendu->ecran_fixe = false; // La disposition de l'image change
+  return true;
+}
+
+void rendu_detruire(t_rendu *rendu)
+{
+  if (rendu == NULL)
+  {
+    return;
+  }
+  if (rendu->ecran_fixe)
+  {
+    // Tout le terminal defile de nouveau ; le curseur repart de la derniere ligne
+    fflush(stdout);
+    ecrire_tout("\033[r\033[999;1H\n", strlen("\033[r\033[999;1H\n"));
+  }
+  free(rendu->tampon);
+  free(rendu->affichees);
+  free(rendu);
+}
+
+bool rendu_afficher(t_rendu *rendu, const t_terrain *terrain, int courante_ligne, int courante_colonne, int destination_ligne, int destination_colonne)
+{
+  t_rendu_scene scene;
+  cadrer_scene(rendu, terrain, courante_ligne, courante_colonne, destination_ligne, destination_colonne, &scene);
+  char *fin = composer_image(rendu, &scene, terrain, rendu->tampon);
+
+  // L'image doit suivre ce qui a deja ete affiche par printf
+  fflush(stdout);
+  return ecrire_tout(rendu->tampon, (size_t)(fin - rendu->tampon));
+}
+
+bool rendu_actualiser(t_rendu *rendu, const t_terrain *terrain, int courante_ligne, int courante_colonne, int destination_ligne, int destination_colonne)
+{
+  t_rendu_scene scene;
+  cadrer_scene(rendu, terrain, courante_ligne, courante_colonne, destination_ligne, destination_colonne, &scene);
+  int hauteur;
+  if (!terminal_assez_grand(&scene, &hauteur))
+  {
+    return rendu_afficher(rendu, terrain, courante_ligne, courante_colonne, destination_ligne, destination_colonne);
+  }
+
+  // Une image disposee autrement que celle affichee (autre terrain, autre niveau de minicarte) est redessinee
+  if (rendu->ecran_fixe &&
+      (memcmp(scene.nb_lignes, rendu->scene_fixee.nb_lignes, sizeof(scene.nb_lignes)) != 0 ||
+       memcmp(scene.nb_colonnes, rendu->scene_fixee.nb_colonnes, sizeof(scene.nb_colonnes)) != 0))
+  {
+    rendu->ecran_fixe = false;
+  }
+
+  char *fin = rendu->tampon;
+  if (rendu->ecran_fixe)
+  {
+    // Seules les cases qui ont change sont reecrites, curseur sauvegarde pour reprendre le texte ou il en etait
+    const char *limite = rendu->tampon + rendu->capacite - RENDU_OCTETS_COMMANDES;
+    t_rendu_famille courante = RENDU_AUCUNE;
+    memcpy(fin, "\0337", 2);
+    fin += 2;
+    for (int zone = 0; zone < RENDU_NB_ZONES && fin != NULL; zone++)
+    {
+      int largeur_case = zone == RENDU_FENETRE ? RENDU_LARGEUR_CASE : 1;
+      for (int i = 0; i < scene.nb_lignes[zone] && fin != NULL; i++)
+      {
+        int suivante = -1; // La colonne ou se trouve le curseur, si elle est sur cette ligne
+        for (int j = 0; j < scene.nb_colonnes[zone]; j++)
+        {
+          uint16_t contenu = contenu_case(rendu, &scene, terrain, zone, i, j);
+          uint16_t *ancien = &rendu->affichees[scene.decalage[zone] + (size_t)i * (size_t)scene.nb_colonnes[zone] + (size_t)j];
+          if (*ancien == contenu)
+          {
+            continue;
+          }
+          if (fin + RENDU_OCTETS_PAR_MISE_A_JOUR > limite)
+          {
+            fin = NULL; // Trop de changements : on redessine tout
+            break;
+          }
+          if (j != suivante)
+          {
+            fin = ecrire_position(fin, scene.premiere_ligne[zone] + i, j * largeur_case + 1);
+          }
+          fin = ecrire_case(fin, zone, contenu, &courante);
+          *ancien = contenu;
+          suivante = j + 1;
+        }
+      }
+    }
+    if (fin != NULL)
+    {
+      memcpy(fin, COULEUR_RESET "\0338", sizeof(COULEUR_RESET) + 1);
+      fin += sizeof(COULEUR_RESET) + 1;
+    }
+    else
+    {
+      rendu->ecran_fixe = false;
+      fin = rendu->tampon;
+    }
+  }
+
+  if (!rendu->ecran_fixe)
+  {
+    // Ecran efface, image en haut, puis le texte defile seulement sous l'image
+    memcpy(fin, "\033[2J\033[H", 7);
+    fin += 7;
+    fin = composer_image(rendu, &scene, terrain, fin);
+    memcpy(fin, "\033[", 2);
+    fin = ecrire_entier(fin + 2, scene.hauteur + 2);
+    *fin++ = ';';
+    fin = ecrire_entier(fin, hauteur);
+    *fin++ = 'r';
+    fin = ecrire_position(fin, scene.hauteur + 2, 1);
+    rendu->ecran_fixe = true;
+    rendu->scene_fixee = scene;
+  }
+
+  fflush(stdout);
+  if (!ecrire_tout(rendu->tampon, (size_t)(fin - rendu->tampon)))
+  {
+    rendu->ecran_fixe = false; // L'ecran ne correspond plus a l'image retenue
+    return false;
+  }
+  return true;
+}
+
+void rendu_invalider(t_rendu *rendu)
+{
+  rendu->ecran_fixe = false;
+}
+
+// *********************************
+// Definitions des fonctions privees
+// *********************************
+t_rendu_famille famille_case(int ligne, int colonne, uint8_t carburant, int courante_ligne, int courante_colonne, int destination_ligne, int destination_colonne)
+{
+  if (ligne == courante_ligne && colonne == courante_colonne)
+  {
+    return RENDU_JOUEUR;
+  }
+  if (ligne == destination_ligne && colonne == destination_colonne)
+  {
+    return RENDU_SORTIE;
+  }
+  return carburant == 0 ? RENDU_VIDE : RENDU_STATION;
+}
+
+void cadrer_scene(const t_rendu *rendu, const t_terrain *terrain, int courante_ligne, int courante_colonne, int destination_ligne, int destination_colonne, t_rendu_scene *scene)
+{
+  // La fenetre suit la case courante tant qu'elle ne sort pas du terrain
+  int nb_lignes = MIN(rendu->nb_lignes, terrain->nb_lignes);
+  int nb_colonnes = MIN(rendu->nb_colonnes, terrain->nb_colonnes);
+  scene->premiere_ligne[RENDU_FENETRE] = 1;
+  scene->nb_lignes[RENDU_FENETRE] = nb_lignes;
+  scene->nb_colonnes[RENDU_FENETRE] = nb_colonnes;
+  scene->decalage[RENDU_FENETRE] = 0;
+  scene->origine_ligne = MAX(0, MIN(courante_ligne - nb_lignes / 2, terrain->nb_lignes - nb_lignes));
+  scene->origine_colonne = MAX(0, MIN(courante_colonne - nb_colonnes / 2, terrain->nb_colonnes - nb_colonnes));
+
+  // La minicarte vient apres une ligne vide
+  scene->niveau = 0;
+  scene->nb_lignes[RENDU_MINIMAP] = 0;
+  scene->nb_colonnes[RENDU_MINIMAP] = 0;
+  if (rendu->minimap != NULL)
+  {
+    scene->niveau = minimap_choisir_niveau(rendu->minimap, rendu->minimap_lignes, rendu->minimap_colonnes,
+                                           &scene->nb_lignes[RENDU_MINIMAP], &scene->nb_colonnes[RENDU_MINIMAP]);
+  }
+  scene->premiere_ligne[RENDU_MINIMAP] = nb_lignes + 2;
+  scene->decalage[RENDU_MINIMAP] = (size_t)rendu->nb_lignes * (size_t)rendu->nb_colonnes;
+
+  scene->hauteur = nb_lignes + (scene->nb_lignes[RENDU_MINIMAP] > 0 ? 1 + scene->nb_lignes[RENDU_MINIMAP] : 0);
+  scene->largeur = MAX(nb_colonnes * RENDU_LARGEUR_CASE, scene->nb_colonnes[RENDU_MINIMAP]);
+  scene->courante_ligne = courante_ligne;
+  scene->courante_colonne = courante_colonne;
+  scene->destination_ligne = destination_ligne;
+  scene->destination_colonne = destination_colonne;
+}
+
+uint16_t contenu_case(const t_rendu *rendu, const t_rendu_scene *scene, const t_terrain *terrain, t_rendu_zone zone, int ligne, int colonne)
+{
+  if (zone == RENDU_FENETRE)
+  {
+    int ligne_terrain = scene->origine_ligne + ligne;
+    int colonne_terrain = scene->origine_colonne + colonne;
+    uint8_t carburant = terrain->cases[terrain_indice(terrain, ligne_terrain, colonne_terrain)];
+    t_rendu_famille famille = famille_case(ligne_terrain, colonne_terrain, carburant, scene->courante_ligne, scene->courante_colonne,
+                                           scene->destination_ligne, scene->destination_colonne);
+    return (uint16_t)(famille << 8 | carburant);
+  }
+
+  // Le bloc de la case courante, puis celui de la sortie, sont marques quel que soit leur carburant
+  int niveau = scene->niveau;
+  if (scene->courante_ligne >> niveau == ligne && scene->courante_colonne >> niveau == colonne)
+  {
+    return (uint16_t)(RENDU_JOUEUR << 8);
+  }
+  if (scene->destination_ligne >> niveau == ligne && scene->destination_colonne >> niveau == colonne)
+  {
+    return (uint16_t)(RENDU_SORTIE << 8);
+  }
+  int intensite = minimap_intensite(rendu->minimap, niveau, ligne, colonne, rendu->mesure);
+  return (uint16_t)((intensite == 0 ? RENDU_VIDE : RENDU_STATION) << 8 | intensite);
+}
+
+char *ecrire_case(char *fin, t_rendu_zone zone, uint16_t contenu, t_rendu_famille *courante)
+{
+  t_rendu_famille famille = (t_rendu_famille)(contenu >> 8);
+  uint8_t valeur = (uint8_t)(contenu & 0xFF);
+  if (famille != *courante)
+  {
+    fin += couleur_formater(fin, couleurs_familles[famille][0], couleurs_familles[famille][1], couleurs_familles[famille][2]);
+    *courante = famille;
+  }
+
+  if (zone == RENDU_MINIMAP)
+  {
+    // Un seul caractere par bloc
+    *fin++ = famille == RENDU_JOUEUR ? 'X' : famille == RENDU_SORTIE ? 'S' : rampe_minimap[valeur];
+    return fin;
+  }
+  if (famille == RENDU_JOUEUR)
+  {
+    memcpy(fin, "[X]", RENDU_LARGEUR_CASE); // Case courante
+    return fin + RENDU_LARGEUR_CASE;
+  }
+  if (famille == RENDU_SORTIE)
+  {
+    memcpy(fin, "[S]", RENDU_LARGEUR_CASE); // Case de destination
+    return fin + RENDU_LARGEUR_CASE;
+  }
+  return ecrire_carburant(fin, valeur); // Autres cases
+}
+
+char *ecrire_carburant(char *fin, uint8_t carburant)
+{
+  if (carburant >= 100)
+  {
+    *fin++ = (char)('0' + carburant / 100);
+    *fin++ = (char)('0' + carburant / 10 % 10);
+    *fin++ = (char)('0' + carburant % 10);
+    return fin;
+  }
+  *fin++ = carburant >= 10 ? (char)('0' + carburant / 10) : ' ';
+  *fin++ = (char)('0' + carburant % 10);
+  *fin++ = ' ';
+  return fin;
+}
+
+char *ecrire_position(char *fin, int ligne, int colonne)
+{
+  *fin++ = '\033';
+  *fin++ = '[';
+  fin = ecrire_entier(fin, ligne);
+  *fin++ = ';';
+  fin = ecrire_entier(fin, colonne);
+  *fin++ = 'H';
+  return fin;
+}
+
+char *ecrire_entier(char *fin, int valeur)
+{
+  char chiffres[10];
+  int nb = 0;
+  do
+  {
+    chiffres[nb++] = (char)('0' + valeur % 10);
+    valeur /= 10;
+  } while (valeur > 0);
+  while (nb > 0)
+  {
+    *fin++ = chiffres[--nb];
+  }
+  return fin;
+}
+
+char *composer_image(t_rendu *rendu, const t_rendu_scene *scene, const t_terrain *terrain, char *fin)
+{
+  for (int zone = 0; zone < RENDU_NB_ZONES; zone++)
+  {
+    if (zone != RENDU_FENETRE && scene->nb_lignes[zone] > 0)
+    {
+      *fin++ = '\n'; // Une ligne vide avant la minicarte
+    }
+    for (int i = 0; i < scene->nb_lignes[zone]; i++)
+    {
+      t_rendu_famille courante = RENDU_AUCUNE;
+      for (int j = 0; j < scene->nb_colonnes[zone]; j++)
+      {
+        uint16_t contenu = contenu_case(rendu, scene, terrain, zone, i, j);
+        fin = ecrire_case(fin, zone, contenu, &courante);
+        rendu->affichees[scene->decalage[zone] + (size_t)i * (size_t)scene->nb_colonnes[zone] + (size_t)j] = contenu;
+      }
+      memcpy(fin, COULEUR_RESET "\n", sizeof(COULEUR_RESET));
+      fin += sizeof(COULEUR_RESET);
+    }
+  }
+  return fin;
+}
+
+bool terminal_assez_grand(const t_rendu_scene *scene, int *hauteur)
+{
+  // Il faut de la place pour l'image, une ligne vide et au moins quelques lignes de texte
+  struct winsize taille;
+  if (!isatty(STDOUT_FILENO) || ioctl(STDOUT_FILENO, TIOCGWINSZ, &taille) != 0)
+  {
+    return false;
+  }
+  *hauteur = taille.ws_row;
+  return scene->hauteur + 8 <= taille.ws_row && scene->largeur <= taille.ws_col;
+}
+
+bool ecrire_tout(const char *tampon, size_t taille)
+{
+  while (taille > 0)
+  {
+    ssize_t ecrits = write(STDOUT_FILENO, tampon, taille);
+    if (ecrits < 0 && errno == EINTR)
+    {
+      continue;
+    }
+    if (ecrits <= 0)
+    {
+      return false;
+    }
+    tampon += ecrits;
+    taille -= (size_t)ecrits;
+  }
+  return true;
+}
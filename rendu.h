@@ -0,0 +1,110 @@
+#ifndef CODE_RENDU_H
+#define CODE_RENDU_H
+
+#include <stdbool.h> // Pour le type bool
+#include "minimap.h" // Pour les types t_minimap et t_minimap_mesure
+#include "terrain.h" // Pour le type t_terrain
+
+// Taille par defaut de la fenetre d'affichage, en cases : un terrain plus grand n'est montre qu'autour du joueur
+#define RENDU_FENETRE_LIGNES 20
+#define RENDU_FENETRE_COLONNES 25
+
+// Taille maximale par defaut de la minicarte, en caracteres
+#define RENDU_MINIMAP_LIGNES 12
+#define RENDU_MINIMAP_COLONNES 48
+
+// *****************************
+// Definitions des types publics
+// *****************************
+
+/**
+ * @brief Moteur d'affichage du terrain : chaque image est composee dans un tampon dimensionne une
+ * fois pour toutes, puis envoyee au terminal par un seul appel a write. Seule une fenetre de taille
+ * fixe est affichee, centree sur la case courante, suivie au besoin d'une minicarte de tout le
+ * terrain : le cout d'une image ne depend pas de la taille du terrain. Le moteur retient l'image
+ * affichee pour que rendu_actualiser n'envoie que les cases qui ont change.
+ */
+typedef struct s_rendu t_rendu;
+
+// ************************************
+// Declarations des fonctions publiques
+// ************************************
+
+/**
+ * @brief Cree un moteur d'affichage dont la fenetre a les dimensions donnees. Un terrain qui tient
+ * dans la fenetre est affiche en entier ; sinon, seule la partie de la fenetre centree sur la case
+ * courante (et ramenee dans le terrain pres des bords) est affichee.
+ * @name rendu_creer
+ * @param nb_lignes le nombre de lignes de cases de la fenetre
+ * @param nb_colonnes le nombre de colonnes de cases de la fenetre
+ * @return le moteur d'affichage, NULL si les dimensions sont invalides ou si la memoire manque
+ */
+t_rendu *rendu_creer(int nb_lignes, int nb_colonnes);
+
+/**
+ * @brief Ajoute sous la fenetre une minicarte de tout le terrain, lue dans la pyramide donnee : chaque
+ * caractere resume un bloc de cases, d'autant plus dense que le bloc est riche en carburant ; le bloc
+ * du joueur est marque X et celui de la sortie S. Les blocs sont choisis aussi fins que possible dans
+ * la taille donnee. La pyramide doit etre tenue a jour des cases modifiees.
+ * @name rendu_activer_minimap
+ * @param rendu le moteur d'affichage
+ * @param minimap la pyramide du terrain affiche, qui doit rester allouee tant que le moteur sert
+ * @param nb_lignes_max le nombre maximal de lignes de la minicarte
+ * @param nb_colonnes_max le nombre maximal de colonnes de la minicarte
+ * @param mesure le resume du carburant de chaque bloc
+ * @return true si la minicarte est en place, false si les dimensions sont invalides ou si la memoire manque
+ * (le moteur reste alors utilisable, sans minicarte)
+ */
+bool rendu_activer_minimap(t_rendu *rendu, const t_minimap *minimap, int nb_lignes_max, int nb_colonnes_max, t_minimap_mesure mesure);
+
+/**
+ * @brief Libere un moteur d'affichage. Si rendu_actualiser a fixe le terrain en haut du terminal,
+ * tout le terminal defile de nouveau.
+ * @name rendu_detruire
+ * @param rendu le moteur d'affichage (peut etre NULL)
+ */
+void rendu_detruire(t_rendu *rendu);
+
+/**
+ * @brief Affiche la fenetre du terrain comme terrain_afficher, en couleurs : la case courante, la sortie,
+ * les cases vides et les stations ont chacune la leur. Chaque case occupe trois colonnes du terminal.
+ * Une seule sequence de couleur precede chaque suite de cases de meme couleur sur une ligne. La
+ * minicarte suit, si elle est activee. Les sorties en attente de stdout sont videes avant.
+ * @name rendu_afficher
+ * @param rendu le moteur d'affichage
+ * @param terrain le terrain a afficher
+ * @param courante_ligne la ligne de la case courante
+ * @param courante_colonne la colonne de la case courante
+ * @param destination_ligne la ligne de la case de destination
+ * @param destination_colonne la colonne de la case de destination
+ * @return true si l'image a ete entierement ecrite, false si l'ecriture echoue
+ */
+bool rendu_afficher(t_rendu *rendu, const t_terrain *terrain, int courante_ligne, int courante_colonne, int destination_ligne, int destination_colonne);
+
+/**
+ * @brief Affiche la fenetre du terrain en ne renvoyant que ce qui a change depuis l'image precedente.
+ * La premiere fois, l'ecran est efface, l'image dessinee en haut et le defilement limite aux
+ * lignes du dessous, ou s'affiche le texte du jeu. Ensuite, seules les cases qui ont change sont
+ * reecrites, a leur place, par deplacement du curseur : quelques dizaines d'octets par tour, toute
+ * la fenetre au plus quand elle suit le joueur. Si la sortie n'est pas un terminal ou si l'image
+ * n'y tient pas, elle est affichee en entier comme par rendu_afficher.
+ * @name rendu_actualiser
+ * @param rendu le moteur d'affichage
+ * @param terrain le terrain a afficher
+ * @param courante_ligne la ligne de la case courante
+ * @param courante_colonne la colonne de la case courante
+ * @param destination_ligne la ligne de la case de destination
+ * @param destination_colonne la colonne de la case de destination
+ * @return true si l'image a ete entierement ecrite, false si l'ecriture echoue
+ */
+bool rendu_actualiser(t_rendu *rendu, const t_terrain *terrain, int courante_ligne, int courante_colonne, int destination_ligne, int destination_colonne);
+
+/**
+ * @brief Oublie l'image affichee : le prochain rendu_actualiser redessinera tout (apres un
+ * changement de taille du terminal, par exemple).
+ * @name rendu_invalider
+ * @param rendu le moteur d'affichage
+ */
+void rendu_invalider(t_rendu *rendu);
+
+#endif // CODE_RENDU_H
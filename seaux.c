@@ -0,0 +1,89 @@
+#include "seaux.h"
+#include <stdlib.h>
+
+// ***********************************
+// Definitions des fonctions publiques
+// ***********************************
+bool seaux_init(t_seaux *seaux, int ecart_max)
+{
+  seaux->nb_seaux = ecart_max + 1;
+  seaux->seaux = calloc((size_t)seaux->nb_seaux, sizeof(t_seau));
+  seaux->priorite_courante = -1;
+  seaux->taille = 0;
+  if (seaux->seaux == NULL)
+  {
+    seaux->nb_seaux = 0;
+    return false;
+  }
+  return true;
+}
+
+void seaux_liberer(t_seaux *seaux)
+{
+  for (int i = 0; i < seaux->nb_seaux; i++)
+  {
+    free(seaux->seaux[i].indices);
+  }
+  free(seaux->seaux);
+  seaux->seaux = NULL;
+  seaux->nb_seaux = 0;
+  seaux->taille = 0;
+}
+
+void seaux_vider(t_seaux *seaux)
+{
+  for (int i = 0; i < seaux->nb_seaux; i++)
+  {
+    seaux->seaux[i].taille = 0;
+  }
+  seaux->priorite_courante = -1;
+  seaux->taille = 0;
+}
+
+bool seaux_est_vide(const t_seaux *seaux)
+{
+  return seaux->taille == 0;
+}
+
+bool seaux_inserer(t_seaux *seaux, int priorite, int indice)
+{
+  // La premiere insertion fixe l'origine de l'intervalle des priorites
+  if (seaux->priorite_courante < 0)
+  {
+    seaux->priorite_courante = priorite;
+  }
+
+  t_seau *seau = &seaux->seaux[priorite % seaux->nb_seaux];
+  if (seau->taille == seau->capacite)
+  {
+    int nouvelle_capacite = seau->capacite > 0 ? 2 * seau->capacite : 16;
+    int *indices = realloc(seau->indices, (size_t)nouvelle_capacite * sizeof(int));
+    if (indices == NULL)
+    {
+      return false;
+    }
+    seau->indices = indices;
+    seau->capacite = nouvelle_capacite;
+  }
+
+  seau->indices[seau->taille] = indice;
+  seau->taille++;
+  seaux->taille++;
+  return true;
+}
+
+int seaux_extraire_min(t_seaux *seaux, int *priorite)
+{
+  // Avancer jusqu'au premier seau non vide
+  t_seau *seau = &seaux->seaux[seaux->priorite_courante % seaux->nb_seaux];
+  while (seau->taille == 0)
+  {
+    seaux->priorite_courante++;
+    seau = &seaux->seaux[seaux->priorite_courante % seaux->nb_seaux];
+  }
+
+  seau->taille--;
+  seaux->taille--;
+  *priorite = seaux->priorite_courante;
+  return seau->indices[seau->taille];
+}
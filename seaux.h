@@ -0,0 +1,83 @@
+#ifndef CODE_SEAUX_H
+#define CODE_SEAUX_H
+
+#include <stdbool.h> // Pour le type bool
+
+// *****************************
+// Definitions des types publics
+// *****************************
+
+/**
+ * @brief Un seau : la pile des indices de cases qui partagent la meme priorite.
+ */
+typedef struct
+{
+  int *indices; // Les indices lineaires des cases du seau
+  int taille;   // Le nombre d'indices presents
+  int capacite; // Le nombre d'indices allouables sans reallocation
+} t_seau;
+
+/**
+ * @brief File de priorite a seaux de Dial, pour des priorites entieres bornees.
+ * Les priorites presentes a un instant donne doivent tenir dans l'intervalle
+ * [priorite_courante, priorite_courante + ecart_max] : un tableau circulaire de
+ * ecart_max + 1 seaux suffit alors et chaque operation se fait en temps constant amorti.
+ * Comme pour le tas, la diminution de priorite se fait par suppression paresseuse.
+ */
+typedef struct
+{
+  t_seau *seaux;         // Le tableau circulaire des seaux
+  int nb_seaux;          // Le nombre de seaux (ecart_max + 1)
+  int priorite_courante; // La plus petite priorite qui peut encore etre presente (-1 avant la premiere insertion)
+  int taille;            // Le nombre total d'elements presents
+} t_seaux;
+
+// ************************************
+// Declarations des fonctions publiques
+// ************************************
+
+/**
+ * @brief Initialise une file a seaux vide.
+ * @param seaux la file a initialiser
+ * @param ecart_max l'ecart maximal entre la plus petite et la plus grande priorite presentes
+ * @return true si l'allocation a reussi, false sinon
+ */
+bool seaux_init(t_seaux *seaux, int ecart_max);
+
+/**
+ * @brief Libere la memoire occupee par une file a seaux.
+ * @param seaux la file a liberer
+ */
+void seaux_liberer(t_seaux *seaux);
+
+/**
+ * @brief Retire tous les elements de la file sans liberer sa memoire.
+ * @param seaux la file a vider
+ */
+void seaux_vider(t_seaux *seaux);
+
+/**
+ * @brief Indique si la file est vide.
+ * @param seaux la file a tester
+ * @return true si la file ne contient aucun element, false sinon
+ */
+bool seaux_est_vide(const t_seaux *seaux);
+
+/**
+ * @brief Insere une case dans la file.
+ * @param seaux la file
+ * @param priorite la priorite de la case, comprise entre priorite_courante et priorite_courante + ecart_max
+ * @param indice l'indice lineaire de la case
+ * @return true si l'insertion a reussi, false si la memoire manque
+ */
+bool seaux_inserer(t_seaux *seaux, int priorite, int indice);
+
+/**
+ * @brief Retire une case de plus petite priorite.
+ * @param seaux la file, qui ne doit pas etre vide
+ * @param priorite l'adresse ou deposer la priorite de la case retiree
+ * @return l'indice lineaire de la case retiree
+ */
+int seaux_extraire_min(t_seaux *seaux, int *priorite);
+
+#endif // CODE_SEAUX_H
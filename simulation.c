@@ -0,0 +1,202 @@
+#include "simulation.h"
+#include "util.h" // Pour MIN
+#include <stdlib.h>
+
+// **********************************
+// Declarations des fonctions privees
+// **********************************
+/**
+ * @brief Achete un bonus : prend le chemin le moins couteux s'il est praticable avec le carburant
+ * restant apres l'achat, sinon cherche un chemin praticable, et a defaut reprend le chemin le moins
+ * couteux, comme le jeu interactif ; en depose les premieres directions dans conseils.
+ * @name simulation_acheter_bonus
+ * @param simulation la simulation
+ * @return true si un chemin a ete trouve et le bonus debite, false sinon (rien n'est debite)
+ */
+bool simulation_acheter_bonus(t_simulation *simulation);
+
+/**
+ * @brief Calcule le chemin le moins couteux de la position du joueur a la sortie, en entier dans
+ * troncons, que le calcul agrandit s'il le faut.
+ * @name simulation_calculer_chemin
+ * @param simulation la simulation
+ * @return le nombre de troncons du chemin, -1 si la sortie est inaccessible ou si la memoire manque
+ */
+int simulation_calculer_chemin(t_simulation *simulation);
+
+/**
+ * @brief Suit les troncons du chemin le moins couteux et donne le carburant qui restera a l'arrivee.
+ * @name simulation_carburant_arrivee
+ * @param simulation la simulation
+ * @param nb_troncons le nombre de troncons du chemin
+ * @param carburant le carburant au depart du chemin
+ * @return le carburant a l'arrivee, -1 si le joueur tombe en panne en chemin
+ */
+int simulation_carburant_arrivee(const t_simulation *simulation, int nb_troncons, int carburant);
+
+// ***********************************
+// Definitions des fonctions publiques
+// ***********************************
+bool simulation_init(t_simulation *simulation, t_terrain *terrain, t_alea *alea)
+{
+  int joueur_ligne, joueur_colonne, joueur_carburant, destination_ligne, destination_colonne;
+  if (!jeu_init(terrain, alea, &joueur_ligne, &joueur_colonne, &joueur_carburant, &destination_ligne, &destination_colonne))
+  {
+    return false;
+  }
+  return simulation_reprendre(simulation, terrain, joueur_ligne, joueur_colonne, joueur_carburant, destination_ligne, destination_colonne);
+}
+
+bool simulation_reprendre(t_simulation *simulation, t_terrain *terrain, int joueur_ligne, int joueur_colonne, int joueur_carburant, int destination_ligne, int destination_colonne)
+{
+  // Le carburant des stations est compte ici : le terrain doit etre pret avant la reprise
+  simulation->autonomie = autonomie_creer(terrain);
+  simulation->contexte = dijkstra_contexte_creer(terrain);
+  simulation->troncons = NULL;
+  simulation->nb_max_troncons = 0;
+  if (simulation->autonomie == NULL || simulation->contexte == NULL)
+  {
+    simulation_liberer(simulation);
+    return false;
+  }
+
+  simulation->terrain = terrain;
+  simulation->joueur_ligne = joueur_ligne;
+  simulation->joueur_colonne = joueur_colonne;
+  simulation->joueur_carburant = joueur_carburant;
+  simulation->destination_ligne = destination_ligne;
+  simulation->destination_colonne = destination_colonne;
+  simulation->etat = jeu_verifier_fin(joueur_ligne, joueur_colonne, joueur_carburant, destination_ligne, destination_colonne);
+  simulation->nb_pas = 0;
+  simulation->prix_bonus = SIMULATION_PRIX_BONUS;
+  simulation->nb_conseils = 0;
+  return true;
+}
+
+bool simulation_pas(t_simulation *simulation, t_simulation_action action)
+{
+  if (simulation->etat != JEU_ETAT_EN_COURS)
+  {
+    return false;
+  }
+
+  if (action == SIMULATION_ACTION_BONUS)
+  {
+    if (!simulation_acheter_bonus(simulation))
+    {
+      return false;
+    }
+  }
+  else if (jeu_deplacer_joueur(&simulation->joueur_ligne, &simulation->joueur_colonne, (t_direction)action, simulation->terrain))
+  {
+    int ancien_carburant = terrain_get_carburant(simulation->terrain, simulation->joueur_ligne, simulation->joueur_colonne);
+    jeu_maj_carburant_joueur(simulation->joueur_ligne, simulation->joueur_colonne, &simulation->joueur_carburant, simulation->terrain);
+    autonomie_signaler_case_modifiee(simulation->autonomie, simulation->joueur_ligne, simulation->joueur_colonne, ancien_carburant);
+  }
+  else
+  {
+    return false;
+  }
+
+  simulation->nb_pas++;
+  simulation->etat = jeu_verifier_fin(simulation->joueur_ligne, simulation->joueur_colonne, simulation->joueur_carburant,
+                                      simulation->destination_ligne, simulation->destination_colonne);
+  return true;
+}
+
+void simulation_liberer(t_simulation *simulation)
+{
+  autonomie_detruire(simulation->autonomie);
+  dijkstra_contexte_detruire(simulation->contexte);
+  free(simulation->troncons);
+  simulation->autonomie = NULL;
+  simulation->contexte = NULL;
+  simulation->troncons = NULL;
+  simulation->nb_max_troncons = 0;
+}
+
+// *********************************
+// Definitions des fonctions privees
+// *********************************
+bool simulation_acheter_bonus(t_simulation *simulation)
+{
+  if (simulation->joueur_carburant < simulation->prix_bonus)
+  {
+    return false;
+  }
+  int carburant = simulation->joueur_carburant - simulation->prix_bonus;
+  int nb_troncons = simulation_calculer_chemin(simulation);
+  if (nb_troncons < 0)
+  {
+    return false;
+  }
+
+  // Le chemin le moins couteux s'il est praticable, sinon un chemin praticable, et a defaut le moins couteux
+  int nb_pas = -1;
+  if (simulation_carburant_arrivee(simulation, nb_troncons, carburant) < 0)
+  {
+    nb_pas = autonomie_chercher_chemin(simulation->autonomie, simulation->joueur_ligne, simulation->joueur_colonne, carburant,
+                                       simulation->destination_ligne, simulation->destination_colonne, simulation->conseils, NB_CASES_BONUS, NULL);
+  }
+  if (nb_pas >= 0)
+  {
+    simulation->nb_conseils = MIN(nb_pas, NB_CASES_BONUS);
+  }
+  else
+  {
+    // Le debut du chemin le moins couteux, un troncon a la fois
+    simulation->nb_conseils = 0;
+    for (int i = 0; i < nb_troncons && simulation->nb_conseils < NB_CASES_BONUS; i++)
+    {
+      for (int j = 0; j < simulation->troncons[i].longueur && simulation->nb_conseils < NB_CASES_BONUS; j++)
+      {
+        simulation->conseils[simulation->nb_conseils++] = simulation->troncons[i].direction;
+      }
+    }
+  }
+  simulation->joueur_carburant = carburant;
+  return true;
+}
+
+int simulation_calculer_chemin(t_simulation *simulation)
+{
+  int nb_troncons = dijkstra_calculer_chemin(simulation->contexte, simulation->terrain, simulation->joueur_ligne, simulation->joueur_colonne,
+                                             simulation->destination_ligne, simulation->destination_colonne,
+                                             simulation->troncons, simulation->nb_max_troncons, NULL);
+  if (nb_troncons <= simulation->nb_max_troncons)
+  {
+    return nb_troncons;
+  }
+
+  // Le tableau ne grandit que lorsqu'un chemin le depasse : les achats suivants le reutilisent
+  t_dijkstra_troncon *troncons = realloc(simulation->troncons, (size_t)nb_troncons * sizeof(t_dijkstra_troncon));
+  if (troncons == NULL)
+  {
+    return -1;
+  }
+  simulation->troncons = troncons;
+  simulation->nb_max_troncons = nb_troncons;
+  return dijkstra_calculer_chemin(simulation->contexte, simulation->terrain, simulation->joueur_ligne, simulation->joueur_colonne,
+                                  simulation->destination_ligne, simulation->destination_colonne,
+                                  simulation->troncons, simulation->nb_max_troncons, NULL);
+}
+
+int simulation_carburant_arrivee(const t_simulation *simulation, int nb_troncons, int carburant)
+{
+  // Un chemin le moins couteux ne repasse jamais par une case : aucune station n'est comptee deux fois
+  int ligne = simulation->joueur_ligne;
+  int colonne = simulation->joueur_colonne;
+  for (int i = 0; i < nb_troncons; i++)
+  {
+    for (int j = 0; j < simulation->troncons[i].longueur; j++)
+    {
+      if (carburant <= 0)
+      {
+        return -1;
+      }
+      jeu_calculer_voisin(ligne, colonne, simulation->troncons[i].direction, &ligne, &colonne);
+      carburant += terrain_get_carburant(simulation->terrain, ligne, colonne) - COUT_DEPLACEMENT_VOISIN;
+    }
+  }
+  return carburant;
+}
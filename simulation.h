@@ -0,0 +1,106 @@
+#ifndef CODE_SIMULATION_H
+#define CODE_SIMULATION_H
+
+#include <stdbool.h>    // Pour le type bool
+#include "alea.h"       // Pour le type t_alea
+#include "autonomie.h"  // Pour le type t_autonomie
+#include "dijkstra.h"   // Pour NB_CASES_BONUS et les types t_dijkstra_contexte et t_dijkstra_troncon
+#include "jeu.h"        // Pour les types t_direction et t_jeu_etat
+#include "terrain.h"    // Pour le type t_terrain
+
+// Prix d'un bonus de deplacement, en litres de carburant
+#define SIMULATION_PRIX_BONUS 10
+
+// *****************************
+// Definitions des types publics
+// *****************************
+
+/**
+ * @brief Les actions possibles a chaque pas de la simulation : un deplacement dans l'une des quatre
+ * directions (memes valeurs que t_direction), ou l'achat d'un bonus.
+ */
+typedef enum
+{
+  SIMULATION_ACTION_DROITE = DIRECTION_DROITE, // Se deplacer vers la droite
+  SIMULATION_ACTION_BAS = DIRECTION_BAS,       // Se deplacer vers le bas
+  SIMULATION_ACTION_HAUT = DIRECTION_HAUT,     // Se deplacer vers le haut
+  SIMULATION_ACTION_GAUCHE = DIRECTION_GAUCHE, // Se deplacer vers la gauche
+  SIMULATION_ACTION_BONUS                      // Acheter un bonus de deplacement
+} t_simulation_action;
+
+/**
+ * @brief L'etat complet d'une partie, pilotee sans aucune entree ni sortie.
+ * Les champs se lisent directement ; seules les fonctions de ce module les modifient.
+ * Les espaces de travail des bonus sont alloues au debut de la partie et servent a tous ses achats.
+ */
+typedef struct
+{
+  t_terrain *terrain;                      // Le terrain, dont les stations se vident au passage du joueur
+  int joueur_ligne;                        // La ligne du joueur
+  int joueur_colonne;                      // La colonne du joueur
+  int joueur_carburant;                    // Le carburant du joueur
+  int destination_ligne;                   // La ligne de la sortie
+  int destination_colonne;                 // La colonne de la sortie
+  t_jeu_etat etat;                         // L'etat de la partie
+  int nb_pas;                              // Le nombre d'actions acceptees depuis le debut de la partie
+  int prix_bonus;                          // Le prix d'un bonus, SIMULATION_PRIX_BONUS sauf reglage contraire
+  t_direction conseils[NB_CASES_BONUS];    // Les directions donnees par le dernier bonus achete
+  int nb_conseils;                         // Le nombre de directions donnees par le dernier bonus, 0 si aucun
+  t_autonomie *autonomie;                  // L'espace de travail des chemins praticables, tenu a jour des deplacements
+  t_dijkstra_contexte *contexte;           // Le contexte de recherche du chemin le moins couteux
+  t_dijkstra_troncon *troncons;            // Les troncons du dernier chemin le moins couteux, agrandi a la demande
+  int nb_max_troncons;                     // Le nombre de troncons que peut recevoir troncons
+} t_simulation;
+
+// ************************************
+// Declarations des fonctions publiques
+// ************************************
+
+/**
+ * @brief Commence une nouvelle partie sur un terrain, tiree comme par jeu_init : sortie, depart et stations.
+ * @name simulation_init
+ * @param simulation la simulation a initialiser, a liberer avec simulation_liberer
+ * @param terrain le terrain, deja alloue a ses dimensions, que la simulation modifie au fil de la partie
+ * @param alea le generateur dans lequel tirer la partie
+ * @return true si la partie a pu commencer, false si tout le carburant n'a pas pu etre reparti sur les
+ * stations ou si la memoire manque (rien n'est a liberer)
+ */
+bool simulation_init(t_simulation *simulation, t_terrain *terrain, t_alea *alea);
+
+/**
+ * @brief Commence une partie a partir d'une situation donnee, par exemple un terrain charge d'un fichier.
+ * @name simulation_reprendre
+ * @param simulation la simulation a initialiser, a liberer avec simulation_liberer
+ * @param terrain le terrain, que la simulation modifie au fil de la partie
+ * @param joueur_ligne la ligne du joueur
+ * @param joueur_colonne la colonne du joueur
+ * @param joueur_carburant le carburant du joueur
+ * @param destination_ligne la ligne de la sortie
+ * @param destination_colonne la colonne de la sortie
+ * @return true si la partie a pu commencer, false si la memoire manque (rien n'est a liberer)
+ */
+bool simulation_reprendre(t_simulation *simulation, t_terrain *terrain, int joueur_ligne, int joueur_colonne, int joueur_carburant, int destination_ligne, int destination_colonne);
+
+/**
+ * @brief Joue une action, avec les regles du jeu interactif mais sans rien afficher ni lire.
+ * Un deplacement ramasse le carburant de la case d'arrivee et coute COUT_DEPLACEMENT_VOISIN. Un
+ * bonus coute prix_bonus et depose dans conseils, dans le meme ordre de preference que le jeu :
+ * les premieres directions du chemin le moins couteux s'il est praticable avec le carburant restant,
+ * sinon celles d'un chemin praticable cherche sous la contrainte du carburant, et a defaut celles
+ * du chemin le moins couteux.
+ * @name simulation_pas
+ * @param simulation la simulation
+ * @param action l'action a jouer
+ * @return true si l'action a ete jouee, false si elle est refusee (partie terminee, deplacement hors du
+ * terrain, carburant insuffisant ou sortie inaccessible pour un bonus) : l'etat est alors inchange
+ */
+bool simulation_pas(t_simulation *simulation, t_simulation_action action);
+
+/**
+ * @brief Libere les espaces de travail d'une simulation. Le terrain, qui appartient a l'appelant, est conserve.
+ * @name simulation_liberer
+ * @param simulation la simulation
+ */
+void simulation_liberer(t_simulation *simulation);
+
+#endif // CODE_SIMULATION_H
@@ -0,0 +1,179 @@
+#include "tas.h"
+#include <stdlib.h>
+
+// **********************************
+// Declarations des fonctions privees
+// **********************************
+
+/**
+ * @brief Indique si un element doit sortir du tas avant un autre.
+ * @name tas_precede
+ * @param a le premier element
+ * @param b le second element
+ * @return true si a est strictement prioritaire sur b
+ */
+bool tas_precede(t_tas_element a, t_tas_element b);
+
+/**
+ * @brief Fait remonter un element vers la racine jusqu'a retrouver la propriete de tas.
+ * @name tas_remonter
+ * @param tas le tas
+ * @param position la position de l'element a remonter
+ */
+void tas_remonter(t_tas *tas, int position);
+
+/**
+ * @brief Fait descendre un element vers les feuilles jusqu'a retrouver la propriete de tas.
+ * @name tas_descendre
+ * @param tas le tas
+ * @param position la position de l'element a descendre
+ */
+void tas_descendre(t_tas *tas, int position);
+
+// ***********************************
+// Definitions des fonctions publiques
+// ***********************************
+bool tas_init(t_tas *tas, int capacite)
+{
+  if (capacite < 1)
+  {
+    capacite = 1;
+  }
+  tas->elements = malloc((size_t)capacite * sizeof(t_tas_element));
+  tas->taille = 0;
+  tas->capacite = tas->elements != NULL ? capacite : 0;
+  return tas->elements != NULL;
+}
+
+void tas_liberer(t_tas *tas)
+{
+  free(tas->elements);
+  tas->elements = NULL;
+  tas->taille = 0;
+  tas->capacite = 0;
+}
+
+void tas_vider(t_tas *tas)
+{
+  tas->taille = 0;
+}
+
+bool tas_est_vide(const t_tas *tas)
+{
+  return tas->taille == 0;
+}
+
+bool tas_inserer(t_tas *tas, int priorite, int indice)
+{
+  return tas_inserer_cle(tas, priorite, 0, indice);
+}
+
+bool tas_inserer_cle(t_tas *tas, int priorite, int sous_priorite, int indice)
+{
+  if (tas->taille == tas->capacite)
+  {
+    int nouvelle_capacite = tas->capacite > 0 ? 2 * tas->capacite : 16;
+    t_tas_element *elements = realloc(tas->elements, (size_t)nouvelle_capacite * sizeof(t_tas_element));
+    if (elements == NULL)
+    {
+      return false;
+    }
+    tas->elements = elements;
+    tas->capacite = nouvelle_capacite;
+  }
+
+  tas->elements[tas->taille].priorite = priorite;
+  tas->elements[tas->taille].sous_priorite = sous_priorite;
+  tas->elements[tas->taille].indice = indice;
+  tas->taille++;
+  tas_remonter(tas, tas->taille - 1);
+  return true;
+}
+
+t_tas_element tas_consulter_min(const t_tas *tas)
+{
+  return tas->elements[0];
+}
+
+t_tas_element tas_extraire_min(t_tas *tas)
+{
+  t_tas_element min = tas->elements[0];
+
+  tas->taille--;
+  if (tas->taille > 0)
+  {
+    tas->elements[0] = tas->elements[tas->taille];
+    tas_descendre(tas, 0);
+  }
+  return min;
+}
+
+// *********************************
+// Definitions des fonctions privees
+// *********************************
+bool tas_precede(t_tas_element a, t_tas_element b)
+{
+  if (a.priorite != b.priorite)
+  {
+    return a.priorite < b.priorite;
+  }
+  if (a.sous_priorite != b.sous_priorite)
+  {
+    return a.sous_priorite < b.sous_priorite;
+  }
+  return a.indice < b.indice;
+}
+
+void tas_remonter(t_tas *tas, int position)
+{
+  t_tas_element element = tas->elements[position];
+
+  while (position > 0)
+  {
+    int parent = (position - 1) / TAS_ARITE;
+    if (!tas_precede(element, tas->elements[parent]))
+    {
+      break;
+    }
+    tas->elements[position] = tas->elements[parent];
+    position = parent;
+  }
+  tas->elements[position] = element;
+}
+
+void tas_descendre(t_tas *tas, int position)
+{
+  t_tas_element element = tas->elements[position];
+
+  while (true)
+  {
+    int premier_enfant = TAS_ARITE * position + 1;
+    if (premier_enfant >= tas->taille)
+    {
+      break;
+    }
+
+    // Chercher le plus petit des enfants
+    int dernier_enfant = premier_enfant + TAS_ARITE;
+    if (dernier_enfant > tas->taille)
+    {
+      dernier_enfant = tas->taille;
+    }
+    int meilleur = premier_enfant;
+    for (int enfant = premier_enfant + 1; enfant < dernier_enfant; enfant++)
+    {
+      if (tas_precede(tas->elements[enfant], tas->elements[meilleur]))
+      {
+        meilleur = enfant;
+      }
+    }
+
+    if (!tas_precede(tas->elements[meilleur], element))
+    {
+      break;
+    }
+    tas->elements[position] = tas->elements[meilleur];
+    position = meilleur;
+  }
+  tas->elements[position] = element;
+}
@@ -0,0 +1,100 @@
+#ifndef CODE_TAS_H
+#define CODE_TAS_H
+
+#include <stdbool.h> // Pour le type bool
+
+// Nombre d'enfants de chaque noeud du tas (tas d-aire)
+#define TAS_ARITE 4
+
+// *****************************
+// Definitions des types publics
+// *****************************
+
+/**
+ * @brief Un element du tas : une case du terrain et sa priorite.
+ * A priorite egale, l'element de plus petite sous-priorite, puis de plus petit indice, sort en premier.
+ */
+typedef struct
+{
+  int priorite;      // La priorite de l'element (la plus petite sort en premier)
+  int sous_priorite; // La priorite secondaire, qui departage les priorites egales
+  int indice;        // L'indice lineaire de la case associee
+} t_tas_element;
+
+/**
+ * @brief File de priorite min sous forme de tas d-aire stocke dans un tableau dynamique.
+ * La diminution de priorite se fait par suppression paresseuse : on reinsere la case avec
+ * sa nouvelle priorite et c'est a l'utilisateur d'ignorer les elements perimes a l'extraction.
+ */
+typedef struct
+{
+  t_tas_element *elements; // Les elements, ranges en tas
+  int taille;              // Le nombre d'elements presents
+  int capacite;            // Le nombre d'elements allouables sans reallocation
+} t_tas;
+
+// ************************************
+// Declarations des fonctions publiques
+// ************************************
+
+/**
+ * @brief Initialise un tas vide.
+ * @param tas le tas a initialiser
+ * @param capacite le nombre d'elements a reserver d'avance (le tas grandit au besoin)
+ * @return true si l'allocation a reussi, false sinon
+ */
+bool tas_init(t_tas *tas, int capacite);
+
+/**
+ * @brief Libere la memoire occupee par un tas.
+ * @param tas le tas a liberer
+ */
+void tas_liberer(t_tas *tas);
+
+/**
+ * @brief Retire tous les elements du tas sans liberer sa memoire.
+ * @param tas le tas a vider
+ */
+void tas_vider(t_tas *tas);
+
+/**
+ * @brief Indique si le tas est vide.
+ * @param tas le tas a tester
+ * @return true si le tas ne contient aucun element, false sinon
+ */
+bool tas_est_vide(const t_tas *tas);
+
+/**
+ * @brief Insere une case dans le tas, avec une sous-priorite nulle.
+ * @param tas le tas
+ * @param priorite la priorite de la case
+ * @param indice l'indice lineaire de la case
+ * @return true si l'insertion a reussi, false si la memoire manque
+ */
+bool tas_inserer(t_tas *tas, int priorite, int indice);
+
+/**
+ * @brief Insere une case dans le tas avec une priorite a deux composantes, comparees dans l'ordre lexicographique.
+ * @param tas le tas
+ * @param priorite la priorite principale de la case
+ * @param sous_priorite la priorite secondaire de la case
+ * @param indice l'indice lineaire de la case
+ * @return true si l'insertion a reussi, false si la memoire manque
+ */
+bool tas_inserer_cle(t_tas *tas, int priorite, int sous_priorite, int indice);
+
+/**
+ * @brief Retourne, sans le retirer, l'element de plus petite priorite.
+ * @param tas le tas, qui ne doit pas etre vide
+ * @return l'element de plus petite priorite
+ */
+t_tas_element tas_consulter_min(const t_tas *tas);
+
+/**
+ * @brief Retire et retourne l'element de plus petite priorite.
+ * @param tas le tas, qui ne doit pas etre vide
+ * @return l'element de plus petite priorite (et de plus petit indice en cas d'egalite)
+ */
+t_tas_element tas_extraire_min(t_tas *tas);
+
+#endif // CODE_TAS_H
@@ -1,53 +1,451 @@
+// La projection de fichiers en mémoire est une extension POSIX que -std=c11 masque sinon
+#define _POSIX_C_SOURCE 200809L
+
+#include <fcntl.h>
+#include <limits.h>
 #include <stdio.h>
 #include <stdlib.h>
+#include <string.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
 #include <time.h>
+#include <unistd.h>
 #include "terrain.h"
-#include "util.h" // Pour utiliser util_generer_nombre_aleatoire
+
+// ****************************
+// Definitions des types prives
+// ****************************
+// En-tête des fichiers de terrain, suivi des nb_cases octets des cases
+typedef struct
+{
+  char magie[4];          // Toujours "TERR"
+  uint32_t version;       // TERRAIN_FICHIER_VERSION
+  uint32_t taille_entete; // La taille de cet en-tête, et donc le décalage des cases dans le fichier
+  uint32_t disposition;   // La disposition des cases (t_terrain_disposition)
+  int32_t nb_lignes;      // Le nombre de lignes du terrain
+  int32_t nb_colonnes;    // Le nombre de colonnes du terrain
+  int32_t depart_ligne;   // La ligne de départ du joueur
+  int32_t depart_colonne; // La colonne de départ du joueur
+  int32_t sortie_ligne;   // La ligne de la sortie
+  int32_t sortie_colonne; // La colonne de la sortie
+  uint32_t nb_cases;      // Le nombre d'octets de cases qui suivent l'en-tête
+  uint32_t somme;         // La somme de contrôle FNV-1a des cases
+  uint8_t reserve[16];    // Complète l'en-tête à 64 octets pour aligner les cases sur une ligne de cache
+} t_terrain_entete;
+
+_Static_assert(sizeof(t_terrain_entete) == TERRAIN_TAILLE_ENTETE, "l'en-tete des fichiers de terrain doit faire 64 octets");
+
+// **********************************
+// Declarations des fonctions privees
+// **********************************
+/**
+ * @brief Calcule la géométrie d'un terrain (pas, tuiles, taille du tableau, décalages des voisines).
+ * @param terrain le terrain dont on remplit les dimensions
+ * @param nb_lignes le nombre de lignes du terrain
+ * @param nb_colonnes le nombre de colonnes du terrain
+ * @param disposition la disposition des cases en mémoire
+ * @return true si les dimensions sont valides, false sinon
+ */
+bool terrain_dimensionner(t_terrain *terrain, int nb_lignes, int nb_colonnes, t_terrain_disposition disposition);
+
+/**
+ * @brief Calcule la somme de contrôle FNV-1a des cases d'un terrain, bordure comprise.
+ * @param terrain le terrain
+ * @return la somme de contrôle
+ */
+uint32_t terrain_somme_cases(const t_terrain *terrain);
+
+/**
+ * @brief Vérifie que toutes les cases de la bordure valent TERRAIN_BORDURE, pour qu'aucune recherche ne sorte du tableau.
+ * @param terrain le terrain
+ * @return true si la bordure est intacte, false sinon
+ */
+bool terrain_bordure_intacte(const t_terrain *terrain);
+
+/**
+ * @brief Vérifie en un seul parcours du tableau que chaque case vaut au plus STATION_MAX_CARBURANT ou
+ * TERRAIN_BORDURE, et que seules la bordure et le remplissage des tuiles valent TERRAIN_BORDURE ; calcule
+ * au passage la somme de contrôle si elle est demandée.
+ * @param terrain le terrain, dont la bordure est intacte
+ * @param verifier_somme true pour vérifier aussi la somme de contrôle des cases
+ * @param somme la somme de contrôle attendue
+ * @return true si les cases sont valides, false sinon
+ */
+bool terrain_cases_valides(const t_terrain *terrain, bool verifier_somme, uint32_t somme);
+
+/**
+ * @brief Compte les cases d'une ligne trop proches de la sortie pour servir de départ (à une distance de
+ * Manhattan d'au plus TERRAIN_DISTANCE_DEPART) : elles forment un intervalle de colonnes autour de celle de la sortie.
+ * @param terrain le terrain
+ * @param ligne la ligne dont on compte les cases
+ * @param sortie_ligne la ligne de la sortie
+ * @param sortie_colonne la colonne de la sortie
+ * @param premiere l'adresse où déposer la première colonne de l'intervalle
+ * @return le nombre de cases de l'intervalle
+ */
+int terrain_cases_proches(const t_terrain *terrain, int ligne, int sortie_ligne, int sortie_colonne, int *premiere);
 
 // ***********************************
 // Definitions des fonctions publiques
 // ***********************************
 
 /**
- * @brief Propose une position de sortie aléatoire pour un terrain de dimensions NB_LIGNES x NB_COLONNES
+ * @brief Alloue un terrain de dimensions données dont toutes les cases sont à 0 (zéro), entourées de la bordure.
+ * @param nb_lignes le nombre de lignes du terrain
+ * @param nb_colonnes le nombre de colonnes du terrain
+ * @return le terrain alloué, NULL si les dimensions sont invalides ou si la mémoire manque
+ */
+t_terrain *terrain_creer(int nb_lignes, int nb_colonnes)
+{
+  return terrain_creer_disposition(nb_lignes, nb_colonnes, TERRAIN_DISPOSITION_LIGNES);
+}
+
+/**
+ * @brief Alloue un terrain comme terrain_creer, avec une disposition des cases en mémoire donnée.
+ * @param nb_lignes le nombre de lignes du terrain
+ * @param nb_colonnes le nombre de colonnes du terrain
+ * @param disposition la disposition des cases en mémoire
+ * @return le terrain alloué, NULL si les dimensions sont invalides ou si la mémoire manque
+ */
+t_terrain *terrain_creer_disposition(int nb_lignes, int nb_colonnes, t_terrain_disposition disposition)
+{
+  t_terrain *terrain = malloc(sizeof(t_terrain));
+  if (terrain == NULL)
+  {
+    return NULL;
+  }
+  if (!terrain_dimensionner(terrain, nb_lignes, nb_colonnes, disposition))
+  {
+    free(terrain);
+    return NULL;
+  }
+
+  terrain->projection = NULL;
+  terrain->taille_projection = 0;
+  terrain->cases = malloc((size_t)terrain->nb_cases * sizeof(uint8_t));
+  if (terrain->cases == NULL)
+  {
+    free(terrain);
+    return NULL;
+  }
+
+  // Tout marquer comme bordure (remplissage des tuiles compris), puis vider les cases du terrain
+  memset(terrain->cases, TERRAIN_BORDURE, (size_t)terrain->nb_cases);
+  terrain_init(terrain);
+  return terrain;
+}
+
+/**
+ * @brief Libère la mémoire occupée par un terrain.
+ * @param terrain le terrain à libérer (peut être NULL)
+ */
+void terrain_detruire(t_terrain *terrain)
+{
+  if (terrain != NULL)
+  {
+    if (terrain->projection != NULL)
+    {
+      munmap(terrain->projection, terrain->taille_projection);
+    }
+    else
+    {
+      free(terrain->cases);
+    }
+    free(terrain);
+  }
+}
+
+/**
+ * @brief Enregistre un terrain dans un fichier binaire versionné : un en-tête de 64 octets (dimensions,
+ * disposition, départ, sortie, somme de contrôle des cases) suivi des cases telles qu'elles sont en
+ * mémoire, bordure comprise, pour que terrain_charger puisse les projeter sans les recopier.
+ * Le fichier est écrit dans l'ordre des octets de la machine.
+ * @param terrain le terrain à enregistrer
+ * @param chemin le chemin du fichier à écrire
+ * @param depart_ligne la ligne de départ du joueur
+ * @param depart_colonne la colonne de départ du joueur
+ * @param sortie_ligne la ligne de la sortie
+ * @param sortie_colonne la colonne de la sortie
+ * @return true si le fichier a été écrit, false sinon
+ */
+bool terrain_enregistrer(const t_terrain *terrain, const char *chemin, int depart_ligne, int depart_colonne, int sortie_ligne, int sortie_colonne)
+{
+  t_terrain_entete entete;
+  memset(&entete, 0, sizeof(entete));
+  memcpy(entete.magie, "TERR", sizeof(entete.magie));
+  entete.version = TERRAIN_FICHIER_VERSION;
+  entete.taille_entete = sizeof(t_terrain_entete);
+  entete.disposition = (uint32_t)terrain->disposition;
+  entete.nb_lignes = terrain->nb_lignes;
+  entete.nb_colonnes = terrain->nb_colonnes;
+  entete.depart_ligne = depart_ligne;
+  entete.depart_colonne = depart_colonne;
+  entete.sortie_ligne = sortie_ligne;
+  entete.sortie_colonne = sortie_colonne;
+  entete.nb_cases = (uint32_t)terrain->nb_cases;
+  entete.somme = terrain_somme_cases(terrain);
+
+  FILE *fichier = fopen(chemin, "wb");
+  if (fichier == NULL)
+  {
+    return false;
+  }
+  bool ecrit = fwrite(&entete, sizeof(entete), 1, fichier) == 1 &&
+               fwrite(terrain->cases, sizeof(uint8_t), (size_t)terrain->nb_cases, fichier) == (size_t)terrain->nb_cases;
+  return fclose(fichier) == 0 && ecrit;
+}
+
+/**
+ * @brief Charge un terrain écrit par terrain_enregistrer en projetant le fichier en mémoire (mmap) :
+ * les recherches lisent directement les pages du fichier, sans lecture ni copie préalables.
+ * La projection est privée : les stations vidées en cours de partie ne modifient pas le fichier.
+ * L'en-tête, la bordure et le carburant des cases sont toujours vérifiés : une case du terrain au-delà
+ * de STATION_MAX_CARBURANT rendrait négatif le coût pour y entrer. Toutes les cases sont donc lues au
+ * chargement ; la somme de contrôle, calculée pendant ce même parcours, n'est vérifiée que sur demande.
+ * @param chemin le chemin du fichier à charger
+ * @param verifier_somme true pour vérifier la somme de contrôle des cases
+ * @param depart_ligne l'adresse où déposer la ligne de départ du joueur
+ * @param depart_colonne l'adresse où déposer la colonne de départ du joueur
+ * @param sortie_ligne l'adresse où déposer la ligne de la sortie
+ * @param sortie_colonne l'adresse où déposer la colonne de la sortie
+ * @return le terrain, à libérer par terrain_detruire, NULL si le fichier est illisible ou invalide
+ */
+t_terrain *terrain_charger(const char *chemin, bool verifier_somme, int *depart_ligne, int *depart_colonne, int *sortie_ligne, int *sortie_colonne)
+{
+  int descripteur = open(chemin, O_RDONLY);
+  if (descripteur < 0)
+  {
+    return NULL;
+  }
+  t_terrain *terrain = malloc(sizeof(t_terrain));
+  uint32_t somme;
+  if (terrain == NULL || !terrain_lire_entete(descripteur, terrain, depart_ligne, depart_colonne, sortie_ligne, sortie_colonne, &somme))
+  {
+    close(descripteur);
+    free(terrain);
+    return NULL;
+  }
+
+  // La projection reste valide une fois le descripteur fermé
+  size_t taille = sizeof(t_terrain_entete) + (size_t)terrain->nb_cases;
+  void *projection = mmap(NULL, taille, PROT_READ | PROT_WRITE, MAP_PRIVATE, descripteur, 0);
+  close(descripteur);
+  if (projection == MAP_FAILED)
+  {
+    free(terrain);
+    return NULL;
+  }
+
+  terrain->cases = (uint8_t *)projection + sizeof(t_terrain_entete);
+  terrain->projection = projection;
+  terrain->taille_projection = taille;
+  if (!terrain_bordure_intacte(terrain) || !terrain_cases_valides(terrain, verifier_somme, somme))
+  {
+    munmap(projection, taille);
+    free(terrain);
+    return NULL;
+  }
+  return terrain;
+}
+
+/**
+ * @brief Lit et vérifie l'en-tête d'un fichier écrit par terrain_enregistrer, ainsi que la taille du
+ * fichier, et remplit la géométrie du terrain sans en charger les cases (cases et projection à NULL).
+ * @param descripteur le descripteur du fichier, ouvert en lecture
+ * @param terrain le terrain dont on remplit la géométrie
+ * @param depart_ligne l'adresse où déposer la ligne de départ du joueur
+ * @param depart_colonne l'adresse où déposer la colonne de départ du joueur
+ * @param sortie_ligne l'adresse où déposer la ligne de la sortie
+ * @param sortie_colonne l'adresse où déposer la colonne de la sortie
+ * @param somme l'adresse où déposer la somme de contrôle attendue des cases
+ * @return true si l'en-tête est valide, false sinon
+ */
+bool terrain_lire_entete(int descripteur, t_terrain *terrain, int *depart_ligne, int *depart_colonne, int *sortie_ligne, int *sortie_colonne, uint32_t *somme)
+{
+  t_terrain_entete entete;
+  struct stat infos;
+  if (pread(descripteur, &entete, sizeof(entete), 0) != (ssize_t)sizeof(entete) || fstat(descripteur, &infos) != 0)
+  {
+    return false;
+  }
+
+  bool valide = memcmp(entete.magie, "TERR", sizeof(entete.magie)) == 0 &&
+                entete.version == TERRAIN_FICHIER_VERSION &&
+                entete.taille_entete == sizeof(t_terrain_entete) &&
+                entete.disposition <= TERRAIN_DISPOSITION_TUILES &&
+                terrain_dimensionner(terrain, entete.nb_lignes, entete.nb_colonnes, (t_terrain_disposition)entete.disposition) &&
+                entete.nb_cases == (uint32_t)terrain->nb_cases &&
+                (size_t)infos.st_size == sizeof(t_terrain_entete) + (size_t)terrain->nb_cases &&
+                terrain_contient(terrain, entete.depart_ligne, entete.depart_colonne) &&
+                terrain_contient(terrain, entete.sortie_ligne, entete.sortie_colonne);
+  if (!valide)
+  {
+    return false;
+  }
+
+  terrain->cases = NULL;
+  terrain->projection = NULL;
+  terrain->taille_projection = 0;
+  *depart_ligne = entete.depart_ligne;
+  *depart_colonne = entete.depart_colonne;
+  *sortie_ligne = entete.sortie_ligne;
+  *sortie_colonne = entete.sortie_colonne;
+  *somme = entete.somme;
+  return true;
+}
+
+/**
+ * @brief Calcule l'indice d'une case dans le tableau des cases du terrain.
+ * @param terrain le terrain
+ * @param position_ligne la ligne de la case
+ * @param position_colonne la colonne de la case
+ * @return l'indice de la case, qui doit se trouver dans le terrain
+ */
+int terrain_indice(const t_terrain *terrain, int position_ligne, int position_colonne)
+{
+  if (terrain->disposition == TERRAIN_DISPOSITION_LIGNES)
+  {
+    return (position_ligne + 1) * terrain->pas + position_colonne + 1;
+  }
+
+  int ligne = position_ligne + 1;
+  int colonne = position_colonne + 1;
+  int tuile = (ligne / TERRAIN_COTE_TUILE) * terrain->nb_tuiles_par_ligne + colonne / TERRAIN_COTE_TUILE;
+  return tuile * TERRAIN_COTE_TUILE * TERRAIN_COTE_TUILE + (ligne % TERRAIN_COTE_TUILE) * TERRAIN_COTE_TUILE + colonne % TERRAIN_COTE_TUILE;
+}
+
+/**
+ * @brief Retrouve la ligne d'une case à partir de son indice dans le tableau des cases.
+ * @param terrain le terrain
+ * @param indice l'indice de la case
+ * @return la ligne de la case, -1 ou nb_lignes pour une case de la bordure
+ */
+int terrain_ligne(const t_terrain *terrain, int indice)
+{
+  if (terrain->disposition == TERRAIN_DISPOSITION_LIGNES)
+  {
+    return indice / terrain->pas - 1;
+  }
+  int tuile = indice / (TERRAIN_COTE_TUILE * TERRAIN_COTE_TUILE);
+  return (tuile / terrain->nb_tuiles_par_ligne) * TERRAIN_COTE_TUILE + (indice % (TERRAIN_COTE_TUILE * TERRAIN_COTE_TUILE)) / TERRAIN_COTE_TUILE - 1;
+}
+
+/**
+ * @brief Retrouve la colonne d'une case à partir de son indice dans le tableau des cases.
+ * @param terrain le terrain
+ * @param indice l'indice de la case
+ * @return la colonne de la case, -1 ou nb_colonnes pour une case de la bordure
+ */
+int terrain_colonne(const t_terrain *terrain, int indice)
+{
+  if (terrain->disposition == TERRAIN_DISPOSITION_LIGNES)
+  {
+    return indice % terrain->pas - 1;
+  }
+  int tuile = indice / (TERRAIN_COTE_TUILE * TERRAIN_COTE_TUILE);
+  return (tuile % terrain->nb_tuiles_par_ligne) * TERRAIN_COTE_TUILE + indice % TERRAIN_COTE_TUILE - 1;
+}
+
+/**
+ * @brief Calcule l'indice de la voisine d'une case dans une direction, bordure comprise.
+ * Préférer TERRAIN_VOISINE, qui évite l'appel en disposition par lignes.
+ * @param terrain le terrain
+ * @param indice l'indice d'une case du terrain (hors bordure)
+ * @param direction la direction de la voisine, dans l'ordre de t_direction (droite, bas, haut, gauche)
+ * @return l'indice de la voisine, dont la case vaut TERRAIN_BORDURE si elle sort du terrain
+ */
+int terrain_voisine(const t_terrain *terrain, int indice, int direction)
+{
+  if (terrain->disposition == TERRAIN_DISPOSITION_LIGNES)
+  {
+    return indice + terrain->decalages[direction];
+  }
+
+  // Dans une tuile, la voisine est au décalage habituel ; au bord de la tuile, elle est dans la tuile d'à côté
+  const int taille_tuile = TERRAIN_COTE_TUILE * TERRAIN_COTE_TUILE;
+  int dans_tuile = indice % taille_tuile;
+  switch (direction)
+  {
+  case 0: // Droite
+    return dans_tuile % TERRAIN_COTE_TUILE != TERRAIN_COTE_TUILE - 1 ? indice + 1 : indice + taille_tuile - (TERRAIN_COTE_TUILE - 1);
+  case 1: // Bas
+    return dans_tuile < taille_tuile - TERRAIN_COTE_TUILE ? indice + TERRAIN_COTE_TUILE
+                                                           : indice + terrain->nb_tuiles_par_ligne * taille_tuile - (taille_tuile - TERRAIN_COTE_TUILE);
+  case 2: // Haut
+    return dans_tuile >= TERRAIN_COTE_TUILE ? indice - TERRAIN_COTE_TUILE
+                                             : indice - terrain->nb_tuiles_par_ligne * taille_tuile + (taille_tuile - TERRAIN_COTE_TUILE);
+  default: // Gauche
+    return dans_tuile % TERRAIN_COTE_TUILE != 0 ? indice - 1 : indice - taille_tuile + (TERRAIN_COTE_TUILE - 1);
+  }
+}
+
+/**
+ * @brief Propose une position de sortie aléatoire sur un terrain
+ * @param terrain le terrain
+ * @param alea le générateur dans lequel tirer la position
  * @param sortie_ligne l'adresse où déposer une ligne de sortie aléatoire
  * @param sortie_colonne l'adresse où déposer une colonne de sortie aléatoire
  */
-void terrain_generer_position_sortie(int *sortie_ligne, int *sortie_colonne)
+void terrain_generer_position_sortie(const t_terrain *terrain, t_alea *alea, int *sortie_ligne, int *sortie_colonne)
 {
-  *sortie_ligne = util_generer_nombre_aleatoire(0, NB_LIGNES - 1);
-  *sortie_colonne = util_generer_nombre_aleatoire(0, NB_COLONNES - 1);
+  *sortie_ligne = alea_entre(alea, 0, terrain->nb_lignes - 1);
+  *sortie_colonne = alea_entre(alea, 0, terrain->nb_colonnes - 1);
 }
 
 /**
- * @brief Propose une position de départ aléatoire pour un terrain de dimensions NB_LIGNES x NB_COLONNES
+ * @brief Propose une position de départ aléatoire sur un terrain
+ * @param terrain le terrain
+ * @param alea le générateur dans lequel tirer la position
  * @param destination_ligne la ligne de la sortie actuelle
  * @param destination_colonne la colonne de la sortie actuelle
  * @param depart_ligne l'adresse où déposer la ligne choisie aléatoirement
  * @param depart_colonne l'adresse où déposer la colonne choisie aléatoirement
- * @note La distance Manhattan entre la position de départ et la position de sortie doit être plus grande que 10.
+ * @note La distance Manhattan entre la position de départ et la position de sortie doit être plus grande que
+ * TERRAIN_DISTANCE_DEPART : la position est tirée uniformément parmi ces cases, sans essais répétés. Si le
+ * terrain n'en a aucune, le départ est placé dans le coin le plus éloigné de la sortie.
  */
-void terrain_generer_position_depart(int destination_ligne, int destination_colonne, int *depart_ligne, int *depart_colonne)
+void terrain_generer_position_depart(const t_terrain *terrain, t_alea *alea, int destination_ligne, int destination_colonne, int *depart_ligne, int *depart_colonne)
 {
-  int distance;
-  do
+  int premiere;
+  int nb_eloignees = 0;
+  for (int ligne = 0; ligne < terrain->nb_lignes; ligne++)
+  {
+    nb_eloignees += terrain->nb_colonnes - terrain_cases_proches(terrain, ligne, destination_ligne, destination_colonne, &premiere);
+  }
+  if (nb_eloignees == 0)
+  {
+    *depart_ligne = 2 * destination_ligne < terrain->nb_lignes - 1 ? terrain->nb_lignes - 1 : 0;
+    *depart_colonne = 2 * destination_colonne < terrain->nb_colonnes - 1 ? terrain->nb_colonnes - 1 : 0;
+    return;
+  }
+
+  // On cherche la ligne de la case tirée, puis sa colonne en sautant les cases trop proches
+  int rang = (int)alea_borne(alea, (uint32_t)nb_eloignees);
+  for (int ligne = 0; ligne < terrain->nb_lignes; ligne++)
   {
-    *depart_ligne = util_generer_nombre_aleatoire(0, NB_LIGNES - 1);
-    *depart_colonne = util_generer_nombre_aleatoire(0, NB_COLONNES - 1);
-    distance = abs(*depart_ligne - destination_ligne) + abs(*depart_colonne - destination_colonne);
-  } while (distance <= 10);
+    int nb_proches = terrain_cases_proches(terrain, ligne, destination_ligne, destination_colonne, &premiere);
+    int nb_ligne = terrain->nb_colonnes - nb_proches;
+    if (rang < nb_ligne)
+    {
+      *depart_ligne = ligne;
+      *depart_colonne = rang < premiere ? rang : rang + nb_proches;
+      return;
+    }
+    rang -= nb_ligne;
+  }
 }
 
 /**
- * @brief Vérifie qu'une position se trouve bien dans les limites du terrain de NB_LIGNES x NB_COLONNES
+ * @brief Vérifie qu'une position se trouve bien dans les limites du terrain
+ * @param terrain le terrain
  * @param position_ligne la ligne de la case à tester
  * @param position_colonne la colonne de la case à tester
  * @return true si la position se trouve à l'intérieur du terrain, false sinon
  */
-bool terrain_contient(int position_ligne, int position_colonne)
+bool terrain_contient(const t_terrain *terrain, int position_ligne, int position_colonne)
 {
-  return (position_ligne >= 0 && position_ligne < NB_LIGNES &&
-          position_colonne >= 0 && position_colonne < NB_COLONNES);
+  return (position_ligne >= 0 && position_ligne < terrain->nb_lignes &&
+          position_colonne >= 0 && position_colonne < terrain->nb_colonnes);
 }
 
 /**
@@ -57,11 +455,11 @@ bool terrain_contient(int position_ligne, int position_colonne)
  * @param position_colonne la colonne de la case dont on veut connaître la quantité de carburant
  * @return la quantité de carburant présente à cette position
  */
-int terrain_get_carburant(t_terrain terrain, int position_ligne, int position_colonne)
+int terrain_get_carburant(const t_terrain *terrain, int position_ligne, int position_colonne)
 {
-  if (terrain_contient(position_ligne, position_colonne))
+  if (terrain_contient(terrain, position_ligne, position_colonne))
   {
-    return terrain[position_ligne][position_colonne];
+    return terrain->cases[terrain_indice(terrain, position_ligne, position_colonne)];
   }
   return -1; // Retourne -1 si la position est invalide
 }
@@ -71,13 +469,17 @@ int terrain_get_carburant(t_terrain terrain, int position_ligne, int position_co
  * @param terrain le terrain dont on va modifier une case
  * @param position_ligne la ligne de la case à modifier
  * @param position_colonne la colonne de la case à modifier
- * @param carburant le carburant qui se trouvera dans la case
+ * @param carburant le carburant qui se trouvera dans la case, entre 0 et STATION_MAX_CARBURANT
  */
-void terrain_set_carburant(t_terrain terrain, int position_ligne, int position_colonne, int carburant)
+void terrain_set_carburant(t_terrain *terrain, int position_ligne, int position_colonne, int carburant)
 {
-  if (terrain_contient(position_ligne, position_colonne))
+  if (carburant < 0 || carburant > STATION_MAX_CARBURANT)
+  {
+    printf("Carburant invalide : %d\n", carburant);
+  }
+  else if (terrain_contient(terrain, position_ligne, position_colonne))
   {
-    terrain[position_ligne][position_colonne] = carburant;
+    terrain->cases[terrain_indice(terrain, position_ligne, position_colonne)] = (uint8_t)carburant;
   }
   else
   {
@@ -89,13 +491,13 @@ void terrain_set_carburant(t_terrain terrain, int position_ligne, int position_c
  * @brief Initialise toutes les cases d'un terrain à 0 (zéro)
  * @param terrain le terrain dont on veut initialiser les cases
  */
-void terrain_init(t_terrain terrain)
+void terrain_init(t_terrain *terrain)
 {
-  for (int i = 0; i < NB_LIGNES; i++)
+  for (int i = 0; i < terrain->nb_lignes; i++)
   {
-    for (int j = 0; j < NB_COLONNES; j++)
+    for (int j = 0; j < terrain->nb_colonnes; j++)
     {
-      terrain[i][j] = 0;
+      terrain->cases[terrain_indice(terrain, i, j)] = 0;
     }
   }
 }
@@ -103,22 +505,46 @@ void terrain_init(t_terrain terrain)
 /**
  * @brief Crée aléatoirement les stations de carburant sur le terrain. La quantité globale des quantités de carburant des stations est passée en paramètre.
  * @param terrain le terrain sur lequel on veut créer les stations de carburant
+ * @param alea le générateur dans lequel tirer les stations
  * @param quantite_globale la quantité globale de carburant à allouer sur l'ensemble des stations
+ * @return true si toute la quantité a été répartie, false si les cases vides ont manqué ou si la mémoire manque
  */
-void terrain_creer_stations_carburant(t_terrain terrain, int quantite_globale)
+bool terrain_creer_stations_carburant(t_terrain *terrain, t_alea *alea, int quantite_globale)
 {
-  while (quantite_globale > 0)
+  if (quantite_globale <= 0)
   {
-    int ligne = util_generer_nombre_aleatoire(0, NB_LIGNES - 1);
-    int colonne = util_generer_nombre_aleatoire(0, NB_COLONNES - 1);
-    int carburant = util_generer_nombre_aleatoire(1, STATION_MAX_CARBURANT);
-
-    if (terrain[ligne][colonne] == 0)
-    { // Si la case est vide
-      terrain[ligne][colonne] = carburant;
-      quantite_globale -= carburant;
+    return true;
+  }
+  int *libres = malloc((size_t)terrain->nb_lignes * (size_t)terrain->nb_colonnes * sizeof(int));
+  if (libres == NULL)
+  {
+    return false;
+  }
+  int nb_libres = 0;
+  for (int i = 0; i < terrain->nb_lignes; i++)
+  {
+    for (int j = 0; j < terrain->nb_colonnes; j++)
+    {
+      int indice = terrain_indice(terrain, i, j);
+      if (terrain->cases[indice] == 0)
+      { // Si la case est vide
+        libres[nb_libres++] = indice;
+      }
     }
   }
+
+  // Mélange de Fisher-Yates partiel : chaque case vide est tirée au plus une fois, et on s'arrête dès que la quantité est répartie
+  for (int nb_tirees = 0; quantite_globale > 0 && nb_tirees < nb_libres; nb_tirees++)
+  {
+    int choisie = nb_tirees + (int)alea_borne(alea, (uint32_t)(nb_libres - nb_tirees));
+    int indice = libres[choisie];
+    libres[choisie] = libres[nb_tirees];
+    int carburant = alea_entre(alea, 1, STATION_MAX_CARBURANT);
+    terrain->cases[indice] = (uint8_t)carburant;
+    quantite_globale -= carburant;
+  }
+  free(libres);
+  return quantite_globale <= 0;
 }
 
 /**
@@ -130,11 +556,11 @@ void terrain_creer_stations_carburant(t_terrain terrain, int quantite_globale)
  * @param destination_ligne la ligne de la position de la case de destination
  * @param destination_colonne la colonne de la position de la case de destination
  */
-void terrain_afficher(t_terrain terrain, int courante_ligne, int courante_colonne, int destination_ligne, int destination_colonne)
+void terrain_afficher(const t_terrain *terrain, int courante_ligne, int courante_colonne, int destination_ligne, int destination_colonne)
 {
-  for (int i = 0; i < NB_LIGNES; i++)
+  for (int i = 0; i < terrain->nb_lignes; i++)
   {
-    for (int j = 0; j < NB_COLONNES; j++)
+    for (int j = 0; j < terrain->nb_colonnes; j++)
     {
       if (i == courante_ligne && j == courante_colonne)
       {
@@ -146,9 +572,112 @@ void terrain_afficher(t_terrain terrain, int courante_ligne, int courante_colonn
       }
       else
       {
-        printf("%2d ", terrain[i][j]); // Autres cases
+        printf("%2d ", terrain->cases[terrain_indice(terrain, i, j)]); // Autres cases
       }
     }
     printf("\n");
   }
-}
\ No newline at end of file
+}
+
+// *********************************
+// Definitions des fonctions privees
+// *********************************
+bool terrain_dimensionner(t_terrain *terrain, int nb_lignes, int nb_colonnes, t_terrain_disposition disposition)
+{
+  if (nb_lignes <= 0 || nb_colonnes <= 0)
+  {
+    return false;
+  }
+
+  // Dimensions du tableau, bordure comprise, arrondies à des tuiles entières si besoin
+  long long hauteur = (long long)nb_lignes + 2;
+  long long largeur = (long long)nb_colonnes + 2;
+  if (disposition == TERRAIN_DISPOSITION_TUILES)
+  {
+    hauteur = (hauteur + TERRAIN_COTE_TUILE - 1) / TERRAIN_COTE_TUILE * TERRAIN_COTE_TUILE;
+    largeur = (largeur + TERRAIN_COTE_TUILE - 1) / TERRAIN_COTE_TUILE * TERRAIN_COTE_TUILE;
+  }
+  if (hauteur * largeur > INT_MAX)
+  {
+    return false;
+  }
+
+  terrain->nb_lignes = nb_lignes;
+  terrain->nb_colonnes = nb_colonnes;
+  terrain->disposition = disposition;
+  terrain->pas = disposition == TERRAIN_DISPOSITION_TUILES ? TERRAIN_COTE_TUILE : (int)largeur;
+  terrain->nb_tuiles_par_ligne = disposition == TERRAIN_DISPOSITION_TUILES ? (int)(largeur / TERRAIN_COTE_TUILE) : 1;
+  terrain->nb_cases = (int)(hauteur * largeur);
+  terrain->decalages[0] = 1;             // Droite
+  terrain->decalages[1] = terrain->pas;  // Bas
+  terrain->decalages[2] = -terrain->pas; // Haut
+  terrain->decalages[3] = -1;            // Gauche
+  return true;
+}
+
+uint32_t terrain_somme_cases(const t_terrain *terrain)
+{
+  uint32_t somme = 2166136261u;
+  for (int i = 0; i < terrain->nb_cases; i++)
+  {
+    somme = (somme ^ terrain->cases[i]) * 16777619u;
+  }
+  return somme;
+}
+
+bool terrain_bordure_intacte(const t_terrain *terrain)
+{
+  for (int i = -1; i <= terrain->nb_lignes; i++)
+  {
+    if (terrain->cases[terrain_indice(terrain, i, -1)] != TERRAIN_BORDURE ||
+        terrain->cases[terrain_indice(terrain, i, terrain->nb_colonnes)] != TERRAIN_BORDURE)
+    {
+      return false;
+    }
+  }
+  for (int j = 0; j < terrain->nb_colonnes; j++)
+  {
+    if (terrain->cases[terrain_indice(terrain, -1, j)] != TERRAIN_BORDURE ||
+        terrain->cases[terrain_indice(terrain, terrain->nb_lignes, j)] != TERRAIN_BORDURE)
+    {
+      return false;
+    }
+  }
+  return true;
+}
+
+bool terrain_cases_valides(const t_terrain *terrain, bool verifier_somme, uint32_t somme)
+{
+  uint32_t calculee = 2166136261u;
+  long long nb_bordures = 0;
+  for (int i = 0; i < terrain->nb_cases; i++)
+  {
+    uint8_t carburant = terrain->cases[i];
+    if (carburant == TERRAIN_BORDURE)
+    {
+      nb_bordures++;
+    }
+    else if (carburant > STATION_MAX_CARBURANT)
+    {
+      return false;
+    }
+    calculee = (calculee ^ carburant) * 16777619u;
+  }
+
+  // Une case du terrain à TERRAIN_BORDURE serait un mur : il y aurait alors plus de bordures que de cases hors du terrain
+  long long nb_hors_terrain = terrain->nb_cases - (long long)terrain->nb_lignes * terrain->nb_colonnes;
+  return nb_bordures == nb_hors_terrain && (!verifier_somme || calculee == somme);
+}
+
+int terrain_cases_proches(const t_terrain *terrain, int ligne, int sortie_ligne, int sortie_colonne, int *premiere)
+{
+  int rayon = TERRAIN_DISTANCE_DEPART - abs(ligne - sortie_ligne);
+  if (rayon < 0)
+  {
+    *premiere = 0;
+    return 0;
+  }
+  *premiere = sortie_colonne - rayon > 0 ? sortie_colonne - rayon : 0;
+  int derniere = sortie_colonne + rayon < terrain->nb_colonnes - 1 ? sortie_colonne + rayon : terrain->nb_colonnes - 1;
+  return derniere - *premiere + 1;
+}
@@ -2,49 +2,216 @@
 #define CODE_TERRAIN_H
 
 #include <stdbool.h> // Pour le type bool
+#include <stddef.h>  // Pour le type size_t
+#include <stdint.h>  // Pour le type uint8_t
+#include "alea.h"    // Pour le type t_alea
 
-// Taille du terrain
+// Taille par défaut du terrain de jeu
 #define NB_LIGNES 10
 #define NB_COLONNES 10
 
-// Quantité maximale de carburant par case de terrain
+// Quantité maximale de carburant par case de terrain (tient sur un octet)
 #define STATION_MAX_CARBURANT 9
 
+// Distance de Manhattan que la position de départ doit dépasser, quand le terrain le permet
+#define TERRAIN_DISTANCE_DEPART 10
+
+// Valeur des cases de la bordure qui entoure le terrain : aucun déplacement n'y mène
+#define TERRAIN_BORDURE UINT8_MAX
+
+// Version du format des fichiers de terrain écrits par terrain_enregistrer
+#define TERRAIN_FICHIER_VERSION 1
+
+// Taille en octets de l'en-tête des fichiers de terrain, suivi directement des cases
+#define TERRAIN_TAILLE_ENTETE 64
+
+// Nombre de cases du côté d'une tuile en disposition TERRAIN_DISPOSITION_TUILES (une tuile de cases tient dans 64 octets)
+#define TERRAIN_COTE_TUILE 8
+
+/**
+ * @brief Calcule l'indice de la voisine d'une case dans une direction, bordure comprise.
+ * En disposition par lignes, c'est un simple décalage ; sinon, voir terrain_voisine.
+ */
+#define TERRAIN_VOISINE(terrain, indice, direction)                                \
+  ((terrain)->disposition == TERRAIN_DISPOSITION_LIGNES                            \
+       ? (indice) + (terrain)->decalages[direction]                                \
+       : terrain_voisine((terrain), (indice), (direction)))
+
 // *****************************
 // Définitions des types publics
 // *****************************
 
-// Le type pour les cases du terrain
-typedef int t_terrain[NB_LIGNES][NB_COLONNES];
+/**
+ * @brief La disposition des cases du terrain, et de tous les tableaux indicés comme elles, en mémoire.
+ */
+typedef enum
+{
+  TERRAIN_DISPOSITION_LIGNES, // Ligne par ligne : les voisines sont à un décalage d'indice constant
+  TERRAIN_DISPOSITION_TUILES  // Par tuiles carrées de TERRAIN_COTE_TUILE cases, elles-mêmes rangées ligne par ligne :
+                              // les voisines verticales restent proches en mémoire sur les terrains très larges
+} t_terrain_disposition;
+
+/**
+ * @brief Un terrain alloué dynamiquement, dont les dimensions sont choisies à l'exécution.
+ * Le tableau des cases entoure le terrain d'une bordure d'une case valant TERRAIN_BORDURE : les
+ * quatre voisines d'une case du terrain s'obtiennent par TERRAIN_VOISINE sans test de limites.
+ * En disposition par lignes, la case (ligne, colonne) se trouve à l'indice
+ * (ligne + 1) * pas + colonne + 1 ; dans tous les cas, terrain_indice donne son indice.
+ */
+typedef struct
+{
+  int nb_lignes;                     // Le nombre de lignes du terrain
+  int nb_colonnes;                   // Le nombre de colonnes du terrain
+  t_terrain_disposition disposition; // La disposition des cases en mémoire
+  int pas;                           // L'écart entre les indices de deux cases voisines verticalement (dans une même tuile)
+  int nb_tuiles_par_ligne;           // Le nombre de tuiles sur une rangée de tuiles, bordure comprise (1 par lignes)
+  int nb_cases;                      // La taille du tableau des cases, bordure comprise
+  int decalages[4];                  // L'écart d'indice vers la voisine de droite, du bas, du haut et de gauche
+                                     // (ordre de t_direction), à l'intérieur d'une même tuile
+  uint8_t *cases;                    // La quantité de carburant de chaque case, ou TERRAIN_BORDURE
+  void *projection;                  // Le fichier projeté en mémoire qui porte les cases, NULL si elles sont allouées
+  size_t taille_projection;          // La taille de la projection
+} t_terrain;
 
 // ************************************
 // Déclarations des fonctions publiques
 // ************************************
 
 /**
- * @brief Propose une position de sortie aléatoire pour un terrain de dimensions NB_LIGNES x NB_COLONNES
+ * @brief Alloue un terrain de dimensions données dont toutes les cases sont à 0 (zéro), entourées de la bordure.
+ * @param nb_lignes le nombre de lignes du terrain
+ * @param nb_colonnes le nombre de colonnes du terrain
+ * @return le terrain alloué, NULL si les dimensions sont invalides ou si la mémoire manque
+ */
+t_terrain *terrain_creer(int nb_lignes, int nb_colonnes);
+
+/**
+ * @brief Alloue un terrain comme terrain_creer, avec une disposition des cases en mémoire donnée.
+ * @param nb_lignes le nombre de lignes du terrain
+ * @param nb_colonnes le nombre de colonnes du terrain
+ * @param disposition la disposition des cases en mémoire
+ * @return le terrain alloué, NULL si les dimensions sont invalides ou si la mémoire manque
+ */
+t_terrain *terrain_creer_disposition(int nb_lignes, int nb_colonnes, t_terrain_disposition disposition);
+
+/**
+ * @brief Enregistre un terrain dans un fichier binaire versionné : un en-tête de 64 octets (dimensions,
+ * disposition, départ, sortie, somme de contrôle des cases) suivi des cases telles qu'elles sont en
+ * mémoire, bordure comprise, pour que terrain_charger puisse les projeter sans les recopier.
+ * Le fichier est écrit dans l'ordre des octets de la machine.
+ * @param terrain le terrain à enregistrer
+ * @param chemin le chemin du fichier à écrire
+ * @param depart_ligne la ligne de départ du joueur
+ * @param depart_colonne la colonne de départ du joueur
+ * @param sortie_ligne la ligne de la sortie
+ * @param sortie_colonne la colonne de la sortie
+ * @return true si le fichier a été écrit, false sinon
+ */
+bool terrain_enregistrer(const t_terrain *terrain, const char *chemin, int depart_ligne, int depart_colonne, int sortie_ligne, int sortie_colonne);
+
+/**
+ * @brief Charge un terrain écrit par terrain_enregistrer en projetant le fichier en mémoire (mmap) :
+ * les recherches lisent directement les pages du fichier, sans lecture ni copie préalables.
+ * La projection est privée : les stations vidées en cours de partie ne modifient pas le fichier.
+ * L'en-tête, la bordure et le carburant des cases sont toujours vérifiés : une case du terrain au-delà
+ * de STATION_MAX_CARBURANT rendrait négatif le coût pour y entrer. Toutes les cases sont donc lues au
+ * chargement ; la somme de contrôle, calculée pendant ce même parcours, n'est vérifiée que sur demande.
+ * @param chemin le chemin du fichier à charger
+ * @param verifier_somme true pour vérifier la somme de contrôle des cases
+ * @param depart_ligne l'adresse où déposer la ligne de départ du joueur
+ * @param depart_colonne l'adresse où déposer la colonne de départ du joueur
+ * @param sortie_ligne l'adresse où déposer la ligne de la sortie
+ * @param sortie_colonne l'adresse où déposer la colonne de la sortie
+ * @return le terrain, à libérer par terrain_detruire, NULL si le fichier est illisible ou invalide
+ */
+t_terrain *terrain_charger(const char *chemin, bool verifier_somme, int *depart_ligne, int *depart_colonne, int *sortie_ligne, int *sortie_colonne);
+
+/**
+ * @brief Lit et vérifie l'en-tête d'un fichier écrit par terrain_enregistrer, ainsi que la taille du
+ * fichier, et remplit la géométrie du terrain sans en charger les cases (cases et projection à NULL).
+ * @param descripteur le descripteur du fichier, ouvert en lecture
+ * @param terrain le terrain dont on remplit la géométrie
+ * @param depart_ligne l'adresse où déposer la ligne de départ du joueur
+ * @param depart_colonne l'adresse où déposer la colonne de départ du joueur
+ * @param sortie_ligne l'adresse où déposer la ligne de la sortie
+ * @param sortie_colonne l'adresse où déposer la colonne de la sortie
+ * @param somme l'adresse où déposer la somme de contrôle attendue des cases
+ * @return true si l'en-tête est valide, false sinon
+ */
+bool terrain_lire_entete(int descripteur, t_terrain *terrain, int *depart_ligne, int *depart_colonne, int *sortie_ligne, int *sortie_colonne, uint32_t *somme);
+
+/**
+ * @brief Libère la mémoire occupée par un terrain, ou la projection du fichier d'où il a été chargé.
+ * @param terrain le terrain à libérer (peut être NULL)
+ */
+void terrain_detruire(t_terrain *terrain);
+
+/**
+ * @brief Calcule l'indice d'une case dans le tableau des cases du terrain.
+ * @param terrain le terrain
+ * @param position_ligne la ligne de la case
+ * @param position_colonne la colonne de la case
+ * @return l'indice de la case, qui doit se trouver dans le terrain
+ */
+int terrain_indice(const t_terrain *terrain, int position_ligne, int position_colonne);
+
+/**
+ * @brief Retrouve la ligne d'une case à partir de son indice dans le tableau des cases.
+ * @param terrain le terrain
+ * @param indice l'indice de la case
+ * @return la ligne de la case, -1 ou nb_lignes pour une case de la bordure
+ */
+int terrain_ligne(const t_terrain *terrain, int indice);
+
+/**
+ * @brief Retrouve la colonne d'une case à partir de son indice dans le tableau des cases.
+ * @param terrain le terrain
+ * @param indice l'indice de la case
+ * @return la colonne de la case, -1 ou nb_colonnes pour une case de la bordure
+ */
+int terrain_colonne(const t_terrain *terrain, int indice);
+
+/**
+ * @brief Calcule l'indice de la voisine d'une case dans une direction, bordure comprise.
+ * Préférer TERRAIN_VOISINE, qui évite l'appel en disposition par lignes.
+ * @param terrain le terrain
+ * @param indice l'indice d'une case du terrain (hors bordure)
+ * @param direction la direction de la voisine, dans l'ordre de t_direction (droite, bas, haut, gauche)
+ * @return l'indice de la voisine, dont la case vaut TERRAIN_BORDURE si elle sort du terrain
+ */
+int terrain_voisine(const t_terrain *terrain, int indice, int direction);
+
+/**
+ * @brief Propose une position de sortie aléatoire sur un terrain
+ * @param terrain le terrain
+ * @param alea le générateur dans lequel tirer la position
  * @param sortie_ligne l'adresse où déposer une ligne de sortie aléatoire
  * @param sortie_colonne l'adresse où déposer une colonne de sortie aléatoire
  */
-void terrain_generer_position_sortie(int *sortie_ligne, int *sortie_colonne);
+void terrain_generer_position_sortie(const t_terrain *terrain, t_alea *alea, int *sortie_ligne, int *sortie_colonne);
 
 /**
- * @brief Propose une position de départ aléatoire pour un terrain de dimensions NB_LIGNES x NB_COLONNES
+ * @brief Propose une position de départ aléatoire sur un terrain
+ * @param terrain le terrain
+ * @param alea le générateur dans lequel tirer la position
  * @param destination_ligne la ligne de la sortie actuelle
  * @param destination_colonne la colonne de la sortie actuelle
  * @param depart_ligne l'adresse où déposer la ligne choisie aléatoirement
  * @param depart_colonne l'adresse où déposer la colonne choisie aléatoirement
- * @note La distance Manhattan entre la position de départ et la position de sortie doit être plus grande que 10.
+ * @note La distance Manhattan entre la position de départ et la position de sortie doit être plus grande que
+ * TERRAIN_DISTANCE_DEPART : la position est tirée uniformément parmi ces cases, sans essais répétés. Si le
+ * terrain n'en a aucune, le départ est placé dans le coin le plus éloigné de la sortie.
  */
-void terrain_generer_position_depart(int destination_ligne, int destination_colonne, int *depart_ligne, int *depart_colonne);
+void terrain_generer_position_depart(const t_terrain *terrain, t_alea *alea, int destination_ligne, int destination_colonne, int *depart_ligne, int *depart_colonne);
 
 /**
- * @brief Vérifie qu'une position se trouve bien dans les limites du terrain de NB_LIGNES x NB_COLONNES
+ * @brief Vérifie qu'une position se trouve bien dans les limites du terrain
+ * @param terrain le terrain
  * @param position_ligne la ligne de la case à tester
  * @param position_colonne la colonne de la case à tester
  * @return true si la position se trouve à l'intérieur du terrain, false sinon
  */
-bool terrain_contient(int position_ligne, int position_colonne);
+bool terrain_contient(const t_terrain *terrain, int position_ligne, int position_colonne);
 
 /**
  * @brief Retourne la quantité de carburant qui se trouve sur une case donnée du terrain
@@ -53,29 +220,31 @@ bool terrain_contient(int position_ligne, int position_colonne);
  * @param position_colonne la colonne de la case dont on veut connaître la quantité de carburant
  * @return la quantité de carburant présente à cette position
  */
-int terrain_get_carburant(t_terrain terrain, int position_ligne, int position_colonne);
+int terrain_get_carburant(const t_terrain *terrain, int position_ligne, int position_colonne);
 
 /**
  * @brief Initialise la quantité de carburant sur une case du terrain
  * @param terrain le terrain dont on va modifier une case
  * @param position_ligne la ligne de la case à modifier
  * @param position_colonne la colonne de la case à modifier
- * @param carburant le carburant qui se trouvera dans la case
+ * @param carburant le carburant qui se trouvera dans la case, entre 0 et STATION_MAX_CARBURANT
  */
-void terrain_set_carburant(t_terrain terrain, int position_ligne, int position_colonne, int carburant);
+void terrain_set_carburant(t_terrain *terrain, int position_ligne, int position_colonne, int carburant);
 
 /**
  * @brief Initialise toutes les cases d'un terrain à 0 (zéro)
  * @param terrain le terrain dont on veut initialiser les cases
  */
-void terrain_init(t_terrain terrain);
+void terrain_init(t_terrain *terrain);
 
 /**
  * @brief Crée aléatoirement les stations de carburant sur le terrain. La quantité globale des quantités de carburant des stations est passée en paramètre.
  * @param terrain le terrain sur lequel on veut créer les stations de carburant
+ * @param alea le générateur dans lequel tirer les stations
  * @param quantite_globale la quantité globale de carburant à allouer sur l'ensemble des stations
+ * @return true si toute la quantité a été répartie, false si les cases vides ont manqué ou si la mémoire manque
  */
-void terrain_creer_stations_carburant(t_terrain terrain, int quantite_globale);
+bool terrain_creer_stations_carburant(t_terrain *terrain, t_alea *alea, int quantite_globale);
 
 /**
  * @brief Affiche la quantité de carburant pour toutes les cases d'un terrain.
@@ -86,6 +255,6 @@ void terrain_creer_stations_carburant(t_terrain terrain, int quantite_globale);
  * @param destination_ligne la ligne de la position de la case de destination
  * @param destination_colonne la colonne de la position de la case de destination
  */
-void terrain_afficher(t_terrain terrain, int courante_ligne, int courante_colonne, int destination_ligne, int destination_colonne);
+void terrain_afficher(const t_terrain *terrain, int courante_ligne, int courante_colonne, int destination_ligne, int destination_colonne);
 
 #endif // CODE_TERRAIN_H
\ No newline at end of file